@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Bump-pointer arena : an allocation only moves a pointer in the current block,
+// nothing is freed individually. reset() releases everything at once, typically
+// once per iteration (or per cell / per time step).
+//
+// When a block is full, a new block is chained (at least twice as large). At the
+// next reset(), the chain is replaced by a single block of the total size, so that
+// the steady state is one block and no system allocation at all.
+class arena {
+public:
+	static constexpr std::size_t default_alignment = 64 ;
+
+	explicit arena(std::size_t capacity = 1 << 16) {
+		add_block(std::max<std::size_t>(capacity, default_alignment)) ;
+	}
+
+	arena(const arena&) = delete ;
+	arena& operator=(const arena&) = delete ;
+
+	~arena() {
+		for (block& b : m_blocks) {
+			std::free(b.data) ;
+		}
+	}
+
+	// alignment must be a power of 2
+	void* allocate(std::size_t bytes, std::size_t alignment = default_alignment) {
+		std::size_t offset = (m_offset + alignment - 1) & ~(alignment - 1) ;
+		if (offset + bytes > m_blocks.back().size) {
+			add_block(std::max(2 * m_blocks.back().size, bytes + alignment)) ;
+			offset = 0 ;
+		}
+		m_offset = offset + bytes ;
+		m_used += bytes ;
+		return m_blocks.back().data + offset ;
+	}
+
+	template <typename T>
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(allocate(n * sizeof(T), std::max(alignof(T), default_alignment))) ;
+	}
+
+	void reset() {
+		if (m_blocks.size() > 1) {
+			std::size_t total = 0 ;
+			for (block& b : m_blocks) {
+				total += b.size ;
+				std::free(b.data) ;
+			}
+			m_blocks.clear() ;
+			add_block(total) ;
+		}
+		m_offset = 0 ;
+		m_used = 0 ;
+	}
+
+	std::size_t used() const { return m_used ; }  // bytes allocated since the last reset
+	std::size_t capacity() const {
+		std::size_t total = 0 ;
+		for (const block& b : m_blocks) {
+			total += b.size ;
+		}
+		return total ;
+	}
+
+private:
+	struct block {
+		char* data ;
+		std::size_t size ;
+	};
+
+	std::vector<block> m_blocks ;
+	std::size_t m_offset = 0 ;  // in the last block
+	std::size_t m_used = 0 ;
+
+	void add_block(std::size_t size) {
+		size = (size + default_alignment - 1) / default_alignment * default_alignment ;
+		void* data = std::aligned_alloc(default_alignment, size) ;
+		if (data == nullptr) {
+			throw std::bad_alloc() ;
+		}
+		m_blocks.push_back({static_cast<char*>(data), size}) ;
+		m_offset = 0 ;
+	}
+};
+
+
+// STL allocator on top of an arena : deallocate does nothing, the memory comes back
+// at arena::reset(). Containers must not outlive the reset.
+template <typename T>
+class arena_allocator {
+public:
+	using value_type = T ;
+
+	explicit arena_allocator(arena& a) : m_arena(&a) {}
+	template <typename U>
+	arena_allocator(const arena_allocator<U>& other) : m_arena(other.get_arena()) {}
+
+	T* allocate(std::size_t n) { return m_arena->allocate<T>(n) ; }
+	void deallocate(T*, std::size_t) {}
+
+	arena* get_arena() const { return m_arena ; }
+
+private:
+	arena* m_arena ;
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b) { return a.get_arena() == b.get_arena() ; }
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b) { return !(a == b) ; }
@@ -0,0 +1,128 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef XBENCHMARK_USE_XTENSOR
+#include <xtensor/xarray.hpp>
+#include <xtensor/xtensor.hpp>
+#endif
+
+// Recycling pool for expression temporaries : requests are rounded up to a power-of-2 size
+// class (64 bytes at least, 64-byte aligned). A freed block goes to the free list of its class
+// and is handed out again to the next request of the same class, so a loop that builds the
+// same temporary at each iteration only reaches the system on the first one.
+//
+// One pool per thread (local()), no lock. A block freed by another thread goes to the lists of
+// that thread. At most max_cached blocks are kept per class, the others are freed, and the
+// cached blocks are released at thread exit.
+class caching_pool {
+public:
+	static constexpr std::size_t alignment = 64 ;
+	static constexpr std::size_t class_count = 48 ;
+	static constexpr std::size_t max_cached = 8 ;
+
+	static caching_pool& local() {
+		static thread_local caching_pool pool ;
+		return pool ;
+	}
+
+	caching_pool(const caching_pool&) = delete ;
+	caching_pool& operator=(const caching_pool&) = delete ;
+
+	~caching_pool() {
+		for (std::vector<void*>& list : m_free) {
+			for (void* p : list) {
+				std::free(p) ;
+			}
+		}
+	}
+
+	void* allocate(std::size_t bytes) {
+		const std::size_t c = size_class(bytes) ;
+		std::vector<void*>& list = m_free[c] ;
+		if (!list.empty()) {
+			void* p = list.back() ;
+			list.pop_back() ;
+			m_hits++ ;
+			return p ;
+		}
+		m_misses++ ;
+		void* p = std::aligned_alloc(alignment, class_size(c)) ;
+		if (p == nullptr) {
+			throw std::bad_alloc() ;
+		}
+		return p ;
+	}
+
+	// bytes must be the size given to allocate()
+	void deallocate(void* p, std::size_t bytes) {
+		if (p == nullptr) {
+			return ;
+		}
+		std::vector<void*>& list = m_free[size_class(bytes)] ;
+		if (list.size() < max_cached) {
+			list.push_back(p) ;
+		} else {
+			std::free(p) ;
+		}
+	}
+
+	std::size_t hits() const { return m_hits ; }      // requests served from a free list
+	std::size_t misses() const { return m_misses ; }  // requests that reached aligned_alloc
+
+	static std::size_t size_class(std::size_t bytes) {
+		std::size_t c = 0 ;
+		while (class_size(c) < bytes) {
+			c++ ;
+		}
+		return c ;
+	}
+
+	static std::size_t class_size(std::size_t c) { return alignment << c ; }
+
+private:
+	caching_pool() {
+		for (std::vector<void*>& list : m_free) {
+			list.reserve(max_cached) ;
+		}
+	}
+
+	std::array<std::vector<void*>, class_count> m_free ;
+	std::size_t m_hits = 0 ;
+	std::size_t m_misses = 0 ;
+};
+
+
+// Stateless STL allocator on top of the thread's caching_pool
+template <typename T>
+class caching_allocator {
+public:
+	using value_type = T ;
+
+	caching_allocator() = default ;
+	template <typename U>
+	caching_allocator(const caching_allocator<U>&) noexcept {}
+
+	T* allocate(std::size_t n) { return static_cast<T*>(caching_pool::local().allocate(n * sizeof(T))) ; }
+	void deallocate(T* p, std::size_t n) { caching_pool::local().deallocate(p, n * sizeof(T)) ; }
+};
+
+template <typename T, typename U>
+bool operator==(const caching_allocator<T>&, const caching_allocator<U>&) { return true ; }
+template <typename T, typename U>
+bool operator!=(const caching_allocator<T>&, const caching_allocator<U>&) { return false ; }
+
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// xtensor containers allocated from the caching pool. xt::eval(e) builds its temporary with
+// the default allocator whatever the operands, caching_xtensor<T, N>(e) is the same
+// evaluation into a recycled buffer.
+template <typename T, std::size_t N>
+using caching_xtensor = xt::xtensor<T, N, XTENSOR_DEFAULT_LAYOUT, caching_allocator<T>> ;
+
+template <typename T>
+using caching_xarray = xt::xarray<T, XTENSOR_DEFAULT_LAYOUT, caching_allocator<T>> ;
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef XBENCHMARK_USE_XTENSOR
+#include <xtensor/xtensor.hpp>
+#endif
+
+// Allocator adapter turning value-initialisation into default-initialisation :
+// std::vector<T>(n) and resize(n) write n zeros, with this allocator trivial elements are
+// left uninitialised and the kernel producing the result writes them only once.
+// Constructions with arguments (vector(n, value), push_back, ...) are forwarded unchanged.
+template <typename T, typename Allocator = std::allocator<T>>
+class default_init_allocator : public Allocator {
+	using traits = std::allocator_traits<Allocator> ;
+
+public:
+	template <typename U>
+	struct rebind {
+		using other = default_init_allocator<U, typename traits::template rebind_alloc<U>> ;
+	};
+
+	using Allocator::Allocator ;
+
+	default_init_allocator() = default ;
+	template <typename U, typename OtherAllocator>
+	default_init_allocator(const default_init_allocator<U, OtherAllocator>& other) noexcept
+		: Allocator(static_cast<const OtherAllocator&>(other)) {}
+
+	template <typename U>
+	void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value) {
+		::new (static_cast<void*>(p)) U ;
+	}
+
+	template <typename U, typename... Args>
+	void construct(U* p, Args&&... args) {
+		traits::construct(static_cast<Allocator&>(*this), p, std::forward<Args>(args)...) ;
+	}
+};
+
+template <typename T, typename U, typename A, typename B>
+bool operator==(const default_init_allocator<T, A>& a, const default_init_allocator<U, B>& b) {
+	return static_cast<const A&>(a) == static_cast<const B&>(b) ;
+}
+template <typename T, typename U, typename A, typename B>
+bool operator!=(const default_init_allocator<T, A>& a, const default_init_allocator<U, B>& b) { return !(a == b) ; }
+
+
+// std::vector whose size constructor and resize() do not zero-fill
+template <typename T>
+using uninitialized_vector = std::vector<T, default_init_allocator<T>> ;
+
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// xtensor on a uvector with the default-init allocator : no fill at construction or resize,
+// whatever T. For trivial T, xt::xtensor<T, N>::from_shape is already uninitialised, the
+// extra pass comes from xt::zeros or the (shape, value) constructor.
+template <typename T, std::size_t N>
+using uninitialized_xtensor = xt::xtensor_container<xt::uvector<T, default_init_allocator<T>>, N, XTENSOR_DEFAULT_LAYOUT> ;
+#endif
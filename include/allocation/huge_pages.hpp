@@ -0,0 +1,233 @@
+#pragma once
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+
+// Page-size aware allocation of large arrays.
+//
+// page_mode::heap             std::aligned_alloc / std::malloc, historical behaviour
+// page_mode::small            anonymous mmap with MADV_NOHUGEPAGE : 4 KB pages only
+// page_mode::huge             mmap aligned on 2 MB + madvise(MADV_HUGEPAGE) (transparent huge
+//                             pages), MAP_HUGETLB when THP is disabled, 4 KB pages otherwise
+// page_mode::hugetlb          MAP_HUGETLB (reserved pool, vm.nr_hugepages), 4 KB pages otherwise
+//
+// The mode obtained after fallback is kept in a header in front of the data, with the
+// mapping to release : page_free() only needs the pointer.
+//
+// The default mode of the benchmarks comes from the XBENCHMARK_PAGES environment variable
+// (heap, small, huge or hugetlb), heap when it is not set. default_page_alloc / default_page_free
+// allocate in that mode : in heap mode they call std::aligned_alloc / std::malloc and std::free
+// directly, without the header (same size, malloc size class and mmap threshold as before).
+
+enum class page_mode : int { heap = 0, small, huge, hugetlb } ;
+
+constexpr std::size_t huge_page_size = std::size_t(2) << 20 ;
+
+inline const char* page_mode_name(page_mode mode) {
+	switch (mode) {
+		case page_mode::heap :    return "heap" ;
+		case page_mode::small :   return "small" ;
+		case page_mode::huge :    return "huge" ;
+		case page_mode::hugetlb : return "hugetlb" ;
+	}
+	return "unknown" ;
+}
+
+inline page_mode default_page_mode() {
+	static const page_mode mode = [] {
+		const char* env = std::getenv("XBENCHMARK_PAGES") ;
+		std::string name = env ? env : "heap" ;
+		for (page_mode m : {page_mode::small, page_mode::huge, page_mode::hugetlb}) {
+			if (name == page_mode_name(m)) {
+				return m ;
+			}
+		}
+		return page_mode::heap ;
+	}() ;
+	return mode ;
+}
+
+// transparent huge pages : "always", "madvise", "never", or "" if the kernel has no THP
+inline std::string transparent_huge_pages() {
+	std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled") ;
+	std::string word ;
+	while (file >> word) {
+		if (word.size() > 2 && word.front() == '[' && word.back() == ']') {
+			return word.substr(1, word.size() - 2) ;
+		}
+	}
+	return "" ;
+}
+
+inline bool transparent_huge_pages_available() {
+	static const bool available = [] {
+		std::string status = transparent_huge_pages() ;
+		return status == "always" || status == "madvise" ;
+	}() ;
+	return available ;
+}
+
+// bytes of anonymous memory of the process currently backed by transparent huge pages
+inline std::size_t anon_huge_page_bytes() {
+	std::ifstream file("/proc/self/smaps_rollup") ;
+	std::string key ;
+	std::size_t kb ;
+	while (file >> key) {
+		if (key == "AnonHugePages:" && file >> kb) {
+			return kb * 1024 ;
+		}
+	}
+	return 0 ;
+}
+
+
+namespace page_detail {
+
+struct header {
+	void* base ;          // what to free / unmap
+	std::size_t length ;  // mapping length, 0 for the heap
+	page_mode mode ;      // mode obtained
+};
+
+inline std::size_t round_up(std::size_t n, std::size_t multiple) {
+	return (n + multiple - 1) / multiple * multiple ;
+}
+
+inline void* map_small(std::size_t length) {
+	void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) ;
+	if (p == MAP_FAILED) {
+		return nullptr ;
+	}
+#ifdef MADV_NOHUGEPAGE
+	madvise(p, length, MADV_NOHUGEPAGE) ;
+#endif
+	return p ;
+}
+
+// length is a multiple of huge_page_size. The data starts on a 2 MB boundary, the 4 KB
+// page just before it is also mapped and holds the header : no huge page is wasted for it.
+// Returns the start of the mapping (header page), of length + 4096 bytes.
+inline void* map_transparent_huge(std::size_t length) {
+	const std::size_t total = length + huge_page_size + 4096 ;
+	char* p = static_cast<char*>(mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) ;
+	if (p == MAP_FAILED) {
+		return nullptr ;
+	}
+	char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<std::uintptr_t>(p) + 4096, huge_page_size)) ;
+	char* start = aligned - 4096 ;
+	if (start > p) {
+		munmap(p, start - p) ;
+	}
+	munmap(aligned + length, (p + total) - (aligned + length)) ;
+	madvise(aligned, length, MADV_HUGEPAGE) ;
+	return start ;
+}
+
+inline void* map_hugetlb(std::size_t length) {
+#ifdef MAP_HUGETLB
+	void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0) ;
+	return p == MAP_FAILED ? nullptr : p ;
+#else
+	return nullptr ;
+#endif
+}
+
+} // namespace page_detail
+
+
+// alignment : power of 2, at least 16
+inline void* page_alloc(std::size_t bytes, page_mode mode = default_page_mode(), std::size_t alignment = 64) {
+	using namespace page_detail ;
+	std::size_t offset = round_up(sizeof(header), alignment) ;
+	void* base = nullptr ;
+	std::size_t length = 0 ;
+	page_mode obtained = mode ;
+
+	if (mode == page_mode::hugetlb) {
+		length = round_up(offset + bytes, huge_page_size) ;
+		base = map_hugetlb(length) ;
+	} else if (mode == page_mode::huge) {
+		if (transparent_huge_pages_available()) {
+			length = round_up(bytes, huge_page_size) ;
+			base = map_transparent_huge(length) ;
+			length += 4096 ;
+			offset = 4096 ;
+		} else {
+			length = round_up(offset + bytes, huge_page_size) ;
+			base = map_hugetlb(length) ;
+			obtained = page_mode::hugetlb ;
+		}
+	}
+	if (base == nullptr && mode != page_mode::heap) {
+		offset = round_up(sizeof(header), alignment) ;
+		length = round_up(offset + bytes, 4096) ;
+		base = map_small(length) ;
+		obtained = page_mode::small ;
+	}
+	if (base == nullptr) {
+		offset = round_up(sizeof(header), alignment) ;
+		length = 0 ;
+		base = alignment <= 16 ? std::malloc(offset + bytes) : std::aligned_alloc(alignment, round_up(offset + bytes, alignment)) ;
+		obtained = page_mode::heap ;
+		if (base == nullptr) {
+			throw std::bad_alloc() ;
+		}
+	}
+
+	char* data = static_cast<char*>(base) + offset ;
+	header h {base, length, obtained} ;
+	std::memcpy(data - sizeof(header), &h, sizeof(header)) ;
+	return data ;
+}
+
+template <typename T>
+T* page_alloc(std::size_t n, page_mode mode = default_page_mode(), std::size_t alignment = 64) {
+	return static_cast<T*>(page_alloc(n * sizeof(T), mode, alignment)) ;
+}
+
+inline page_mode allocated_page_mode(const void* p) {
+	page_detail::header h ;
+	std::memcpy(&h, static_cast<const char*>(p) - sizeof(h), sizeof(h)) ;
+	return h.mode ;
+}
+
+inline void page_free(void* p) {
+	if (p == nullptr) {
+		return ;
+	}
+	page_detail::header h ;
+	std::memcpy(&h, static_cast<char*>(p) - sizeof(h), sizeof(h)) ;
+	if (h.length == 0) {
+		std::free(h.base) ;
+	} else {
+		munmap(h.base, h.length) ;
+	}
+}
+
+
+// alignment <= 16 : std::malloc. The pointer must be released by default_page_free.
+inline void* default_page_alloc(std::size_t bytes, std::size_t alignment = 64) {
+	if (default_page_mode() == page_mode::heap) {
+		return alignment <= 16 ? std::malloc(bytes) : std::aligned_alloc(alignment, bytes) ;
+	}
+	return page_alloc(bytes, default_page_mode(), alignment) ;
+}
+
+template <typename T>
+T* default_page_alloc(std::size_t n, std::size_t alignment = 64) {
+	return static_cast<T*>(default_page_alloc(n * sizeof(T), alignment)) ;
+}
+
+inline void default_page_free(void* p) {
+	if (default_page_mode() == page_mode::heap) {
+		std::free(p) ;
+	} else {
+		page_free(p) ;
+	}
+}
@@ -0,0 +1,250 @@
+#pragma once
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// NUMA placement of the benchmark arrays without libnuma : mbind and move_pages are called
+// through syscall(), the topology is read in /sys/devices/system/node.
+//
+// numa_policy::serial_first_touch     thread 0 writes the whole array : every page on its node
+// numa_policy::parallel_first_touch   each thread writes its own chunk (same split as the compute loop)
+// numa_policy::interleave             pages spread round-robin over the nodes (MPOL_INTERLEAVE)
+// numa_policy::local_bind             each chunk bound to the node of the thread computing it (MPOL_BIND)
+//
+// thread_placement::compact           threads fill the CPUs of node 0 first, then node 1, ...
+// thread_placement::spread            threads distributed round-robin over the nodes
+//
+// Only the CPUs allowed to the process (sched_getaffinity) are used : running under
+// `numactl --physcpubind` restricts the topology accordingly. On a single node machine every
+// policy places the pages on the same node.
+
+enum class numa_policy : int { serial_first_touch = 0, parallel_first_touch, interleave, local_bind } ;
+enum class thread_placement : int { compact = 0, spread } ;
+
+inline const char* numa_policy_name(numa_policy policy) {
+	switch (policy) {
+		case numa_policy::serial_first_touch :   return "serial_first_touch" ;
+		case numa_policy::parallel_first_touch : return "parallel_first_touch" ;
+		case numa_policy::interleave :           return "interleave" ;
+		case numa_policy::local_bind :           return "local_bind" ;
+	}
+	return "unknown" ;
+}
+
+inline const char* thread_placement_name(thread_placement placement) {
+	return placement == thread_placement::compact ? "compact" : "spread" ;
+}
+
+
+namespace numa_detail {
+
+// from <numaif.h>, not included to avoid depending on libnuma-dev
+constexpr int mpol_bind = 2 ;
+constexpr int mpol_interleave = 3 ;
+constexpr unsigned mpol_mf_move = 1u << 1 ;
+
+constexpr std::size_t max_nodes = 1024 ;
+using node_mask = std::array<unsigned long, max_nodes / (8 * sizeof(unsigned long))> ;
+
+inline void set_node(node_mask& mask, int node) {
+	mask[node / (8 * sizeof(unsigned long))] |= 1ul << (node % (8 * sizeof(unsigned long))) ;
+}
+
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+inline std::vector<int> parse_cpu_list(const std::string& list) {
+	std::vector<int> cpus ;
+	std::stringstream stream(list) ;
+	std::string range ;
+	while (std::getline(stream, range, ',')) {
+		if (range.empty() || range == "\n") {
+			continue ;
+		}
+		std::size_t dash = range.find('-') ;
+		int first = std::stoi(range.substr(0, dash)) ;
+		int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1)) ;
+		for (int cpu = first ; cpu <= last ; cpu++) {
+			cpus.push_back(cpu) ;
+		}
+	}
+	return cpus ;
+}
+
+} // namespace numa_detail
+
+
+// Nodes are indexed 0 .. nodes() - 1 in this class, node_id() gives the kernel id
+// (node directories can be non-contiguous). Nodes without allowed CPU are ignored.
+class numa_topology {
+public:
+	static const numa_topology& get() {
+		static const numa_topology topology ;
+		return topology ;
+	}
+
+	int nodes() const { return static_cast<int>(m_cpus.size()) ; }
+	int node_id(int node) const { return m_node_ids[node] ; }
+	const std::vector<int>& cpus(int node) const { return m_cpus[node] ; }
+
+	int ncpus() const {
+		int count = 0 ;
+		for (const std::vector<int>& cpus : m_cpus) {
+			count += static_cast<int>(cpus.size()) ;
+		}
+		return count ;
+	}
+
+	// node index of a CPU, 0 if unknown
+	int node_of_cpu(int cpu) const {
+		for (int node = 0 ; node < nodes() ; node++) {
+			for (int c : m_cpus[node]) {
+				if (c == cpu) {
+					return node ;
+				}
+			}
+		}
+		return 0 ;
+	}
+
+	// node index of a kernel node id, -1 if unknown
+	int node_of_id(int id) const {
+		for (int node = 0 ; node < nodes() ; node++) {
+			if (m_node_ids[node] == id) {
+				return node ;
+			}
+		}
+		return -1 ;
+	}
+
+	// CPU of the thread-th thread ; threads beyond the number of CPUs wrap around
+	int cpu(thread_placement placement, int thread) const {
+		if (placement == thread_placement::spread) {
+			const std::vector<int>& cpus = m_cpus[thread % nodes()] ;
+			return cpus[(thread / nodes()) % cpus.size()] ;
+		}
+		thread %= ncpus() ;
+		for (const std::vector<int>& cpus : m_cpus) {
+			if (thread < static_cast<int>(cpus.size())) {
+				return cpus[thread] ;
+			}
+			thread -= static_cast<int>(cpus.size()) ;
+		}
+		return 0 ;
+	}
+
+private:
+	std::vector<std::vector<int>> m_cpus ;
+	std::vector<int> m_node_ids ;
+
+	numa_topology() {
+		cpu_set_t allowed ;
+		CPU_ZERO(&allowed) ;
+		bool restricted = sched_getaffinity(0, sizeof(allowed), &allowed) == 0 ;
+		for (int id = 0 ; id < static_cast<int>(numa_detail::max_nodes) ; id++) {
+			std::ifstream file("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist") ;
+			if (!file) {
+				continue ;
+			}
+			std::string list ;
+			std::getline(file, list) ;
+			std::vector<int> cpus ;
+			for (int cpu : numa_detail::parse_cpu_list(list)) {
+				if (!restricted || CPU_ISSET(cpu, &allowed)) {
+					cpus.push_back(cpu) ;
+				}
+			}
+			if (!cpus.empty()) {
+				m_cpus.push_back(cpus) ;
+				m_node_ids.push_back(id) ;
+			}
+		}
+		// no sysfs (or no allowed CPU found) : a single node with every CPU
+		if (m_cpus.empty()) {
+			std::vector<int> cpus ;
+			int count = std::max(1u, std::thread::hardware_concurrency()) ;
+			for (int cpu = 0 ; cpu < count ; cpu++) {
+				if (!restricted || CPU_ISSET(cpu, &allowed)) {
+					cpus.push_back(cpu) ;
+				}
+			}
+			m_cpus.push_back(cpus.empty() ? std::vector<int>{0} : cpus) ;
+			m_node_ids.push_back(0) ;
+		}
+	}
+};
+
+
+// Pins the calling thread on one CPU, the previous affinity is restored at destruction
+// (benchmark thread 0 is the main thread, it must not stay pinned for the next benchmarks).
+class thread_pin {
+public:
+	explicit thread_pin(int cpu) {
+		CPU_ZERO(&m_saved) ;
+		m_pinned = sched_getaffinity(0, sizeof(m_saved), &m_saved) == 0 ;
+		cpu_set_t set ;
+		CPU_ZERO(&set) ;
+		CPU_SET(cpu, &set) ;
+		m_pinned = m_pinned && sched_setaffinity(0, sizeof(set), &set) == 0 ;
+	}
+
+	thread_pin(const thread_pin&) = delete ;
+	thread_pin& operator=(const thread_pin&) = delete ;
+
+	~thread_pin() {
+		if (m_pinned) {
+			sched_setaffinity(0, sizeof(m_saved), &m_saved) ;
+		}
+	}
+
+	bool pinned() const { return m_pinned ; }
+
+private:
+	cpu_set_t m_saved ;
+	bool m_pinned = false ;
+};
+
+
+// Policies on an address range : p must be page aligned, the pages must not be touched yet
+// for the placement to apply (MPOL_MF_MOVE migrates the pages already there when possible).
+// They return false when the kernel refuses (no NUMA support, seccomp in a container, ...).
+inline bool numa_interleave(void* p, std::size_t bytes) {
+	const numa_topology& topology = numa_topology::get() ;
+	numa_detail::node_mask mask {} ;
+	for (int node = 0 ; node < topology.nodes() ; node++) {
+		numa_detail::set_node(mask, topology.node_id(node)) ;
+	}
+	return syscall(SYS_mbind, p, bytes, numa_detail::mpol_interleave, mask.data(), numa_detail::max_nodes, numa_detail::mpol_mf_move) == 0 ;
+}
+
+inline bool numa_bind(void* p, std::size_t bytes, int node) {
+	numa_detail::node_mask mask {} ;
+	numa_detail::set_node(mask, numa_topology::get().node_id(node)) ;
+	return syscall(SYS_mbind, p, bytes, numa_detail::mpol_bind, mask.data(), numa_detail::max_nodes, numa_detail::mpol_mf_move) == 0 ;
+}
+
+// Node index of the pages [p, p + count * page) (move_pages without target : query only),
+// -1 for a page not present or when the query fails.
+inline std::vector<int> numa_page_nodes(const void* p, std::size_t count, std::size_t page = 4096) {
+	std::vector<void*> pages(count) ;
+	std::vector<int> status(count, -1) ;
+	for (std::size_t i = 0 ; i < count ; i++) {
+		pages[i] = const_cast<char*>(static_cast<const char*>(p)) + i * page ;
+	}
+	if (syscall(SYS_move_pages, 0, count, pages.data(), nullptr, status.data(), 0) != 0) {
+		return std::vector<int>(count, -1) ;
+	}
+	const numa_topology& topology = numa_topology::get() ;
+	for (int& node : status) {
+		node = node < 0 ? -1 : topology.node_of_id(node) ;
+	}
+	return status ;
+}
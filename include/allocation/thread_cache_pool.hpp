@@ -0,0 +1,211 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Thread-caching size-class pool, in the spirit of tcmalloc : requests up to max_size bytes
+// are rounded up to a power-of-2 size class. Each thread keeps a free list per class and
+// allocates / frees without any lock ; a miss takes a batch of blocks from the central list of
+// the class (one mutex per class), a cache holding more than cache_limit blocks gives a batch
+// back. A block freed by another thread goes into the cache of the freeing thread.
+//
+// Every block is preceded by a 16-byte header holding its class, so that deallocate() only
+// needs the pointer. Larger requests go to malloc. Memory is carved from span_size spans that
+// are only returned to the system at exit. The thread caches are thread_local : there is a
+// single pool per process, instance().
+class thread_cache_pool {
+public:
+	static constexpr std::size_t header_size = 16 ;
+	static constexpr std::size_t min_size = 16 ;
+	static constexpr std::size_t class_count = 12 ;                     // 16 B ... 32 KB
+	static constexpr std::size_t max_size = min_size << (class_count - 1) ;
+	static constexpr std::size_t batch = 32 ;
+	static constexpr std::size_t cache_limit = 4 * batch ;
+	static constexpr std::size_t span_size = std::size_t(1) << 20 ;
+
+	static thread_cache_pool& instance() {
+		static thread_cache_pool pool ;
+		return pool ;
+	}
+
+	thread_cache_pool(const thread_cache_pool&) = delete ;
+	thread_cache_pool& operator=(const thread_cache_pool&) = delete ;
+
+	~thread_cache_pool() {
+		for (void* span : m_spans) {
+			std::free(span) ;
+		}
+	}
+
+	void* allocate(std::size_t bytes) {
+		if (bytes > max_size) {
+			char* p = static_cast<char*>(std::malloc(bytes + header_size)) ;
+			if (p == nullptr) {
+				throw std::bad_alloc() ;
+			}
+			set_class(p, large_class) ;
+			return p + header_size ;
+		}
+		const std::size_t c = size_class(bytes) ;
+		thread_cache& cache = local_cache() ;
+		if (cache.head[c] == nullptr) {
+			refill(cache, c) ;
+		}
+		free_block* block = cache.head[c] ;
+		cache.head[c] = block->next ;
+		cache.count[c]-- ;
+		char* p = reinterpret_cast<char*>(block) ;
+		set_class(p, c) ;
+		return p + header_size ;
+	}
+
+	void deallocate(void* ptr) {
+		if (ptr == nullptr) {
+			return ;
+		}
+		char* p = static_cast<char*>(ptr) - header_size ;
+		const std::size_t c = get_class(p) ;
+		if (c == large_class) {
+			std::free(p) ;
+			return ;
+		}
+		thread_cache& cache = local_cache() ;
+		free_block* block = reinterpret_cast<free_block*>(p) ;
+		block->next = cache.head[c] ;
+		cache.head[c] = block ;
+		cache.count[c]++ ;
+		if (cache.count[c] > cache_limit) {
+			release(cache, c, batch) ;
+		}
+	}
+
+	// smallest class holding bytes
+	static std::size_t size_class(std::size_t bytes) {
+		std::size_t c = 0 ;
+		while ((min_size << c) < bytes) {
+			c++ ;
+		}
+		return c ;
+	}
+
+	// central list refills since the creation of the pool, all threads together
+	std::size_t refills() const {
+		std::size_t total = 0 ;
+		for (const central_list& list : m_central) {
+			std::lock_guard<std::mutex> lock(list.mutex) ;
+			total += list.refills ;
+		}
+		return total ;
+	}
+
+private:
+	static constexpr std::size_t large_class = class_count ;
+
+	thread_cache_pool() = default ;
+
+	struct free_block {
+		free_block* next ;
+	};
+
+	struct central_list {
+		mutable std::mutex mutex ;
+		free_block* head = nullptr ;
+		std::size_t refills = 0 ;
+	};
+
+	struct thread_cache {
+		thread_cache_pool* pool = nullptr ;
+		std::array<free_block*, class_count> head {} ;
+		std::array<std::size_t, class_count> count {} ;
+
+		// the blocks of an exiting thread go back to the central lists
+		~thread_cache() {
+			if (pool != nullptr) {
+				for (std::size_t c = 0 ; c < class_count ; c++) {
+					pool->release(*this, c, count[c]) ;
+				}
+			}
+		}
+	};
+
+	std::array<central_list, class_count> m_central ;
+	std::mutex m_span_mutex ;
+	std::vector<void*> m_spans ;
+
+	thread_cache& local_cache() {
+		static thread_local thread_cache cache ;
+		cache.pool = this ;
+		return cache ;
+	}
+
+	static void set_class(char* p, std::size_t c) {
+		*reinterpret_cast<std::size_t*>(p) = c ;
+	}
+
+	static std::size_t get_class(const char* p) {
+		return *reinterpret_cast<const std::size_t*>(p) ;
+	}
+
+	static std::size_t block_size(std::size_t c) {
+		return header_size + (min_size << c) ;
+	}
+
+	void refill(thread_cache& cache, std::size_t c) {
+		central_list& list = m_central[c] ;
+		std::lock_guard<std::mutex> lock(list.mutex) ;
+		list.refills++ ;
+		if (list.head == nullptr) {
+			list.head = carve(c) ;
+		}
+		for (std::size_t k = 0 ; k < batch && list.head != nullptr ; k++) {
+			free_block* block = list.head ;
+			list.head = block->next ;
+			block->next = cache.head[c] ;
+			cache.head[c] = block ;
+			cache.count[c]++ ;
+		}
+	}
+
+	// new span cut in blocks of class c, returned as a list
+	free_block* carve(std::size_t c) {
+		const std::size_t size = block_size(c) ;
+		const std::size_t bytes = std::max(span_size, batch * size) ;
+		char* span = static_cast<char*>(std::aligned_alloc(header_size, bytes)) ;
+		if (span == nullptr) {
+			throw std::bad_alloc() ;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_span_mutex) ;
+			m_spans.push_back(span) ;
+		}
+		free_block* head = nullptr ;
+		for (std::size_t offset = 0 ; offset + size <= bytes ; offset += size) {
+			free_block* block = reinterpret_cast<free_block*>(span + offset) ;
+			block->next = head ;
+			head = block ;
+		}
+		return head ;
+	}
+
+	void release(thread_cache& cache, std::size_t c, std::size_t n) {
+		if (n == 0) {
+			return ;
+		}
+		free_block* first = cache.head[c] ;
+		free_block* last = first ;
+		for (std::size_t k = 1 ; k < n ; k++) {
+			last = last->next ;
+		}
+		cache.head[c] = last->next ;
+		cache.count[c] -= n ;
+		central_list& list = m_central[c] ;
+		std::lock_guard<std::mutex> lock(list.mutex) ;
+		last->next = list.head ;
+		list.head = first ;
+	}
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+
+#include <utils/isa_dispatch.hpp>
+
+// Kernels compiled once per ISA level (include/utils/isa_dispatch.hpp). Each body is a plain
+// loop left to the auto-vectoriser, inlined into one function per level carrying the target
+// attribute of that level : the versions only differ by the instructions the compiler may use.
+// isa_kernels<L> holds the version of level L, dispatch_isa(active_isa(), ...) picks one at run
+// time.
+//
+// - map(result, n, f, in...)              : result[i] = f(in[i]...)
+// - masked_add(a, b, mask, result, n)     : result[i] = mask[i] ? a[i] + b[i] : result[i]
+// - find_first(data, n, pred)             : index of the first pred(data[i]), -1 if none. Blocks
+//   of 64 elements are reduced to a count of matches (vectorised, no early exit inside a
+//   block), the block holding the match is then scanned element by element. An int count
+//   vectorises much better than a bool |= reduction.
+//
+// f and pred must be inline callables (lambdas, std::plus...) : they are inlined into the
+// versions, which needs the caller to be compiled for a superset of their ISA. This is the
+// case for the baseline of the build.
+
+template <typename T, typename F, typename... In>
+__attribute__((always_inline)) inline void isa_map_body(T* result, std::size_t n, F f, const In*... in) {
+	for (std::size_t i = 0 ; i < n ; i++) {
+		result[i] = f(in[i]...) ;
+	}
+}
+
+template <typename T>
+__attribute__((always_inline)) inline void isa_masked_add_body(const T* a, const T* b, const bool* mask, T* result, std::size_t n) {
+	// the mask read as bytes : GCC finds no vector type for bool. The loop becomes a
+	// conditional store, vectorised with AVX-512 masked stores only.
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(mask) ;
+	for (std::size_t i = 0 ; i < n ; i++) {
+		result[i] = bytes[i] ? a[i] + b[i] : result[i] ;
+	}
+}
+
+template <typename T, typename Pred>
+__attribute__((always_inline)) inline int isa_find_first_body(const T* data, std::size_t n, Pred pred) {
+	constexpr std::size_t block = 64 ;
+	std::size_t i = 0 ;
+	for (; i + block <= n ; i += block) {
+		int found = 0 ;
+		for (std::size_t k = 0 ; k < block ; k++) {
+			found += pred(data[i + k]) ;
+		}
+		if (found != 0) {
+			break ;
+		}
+	}
+	for (; i < n ; i++) {
+		if (pred(data[i])) {
+			return static_cast<int>(i) ;
+		}
+	}
+	return -1 ;
+}
+
+
+template <isa_level L>
+struct isa_kernels ;
+
+#define XBENCHMARK_ISA_KERNELS(LEVEL, TARGET)                                                          \
+	template <>                                                                                    \
+	struct isa_kernels<isa_level::LEVEL> {                                                         \
+		template <typename T, typename F, typename... In>                                      \
+		TARGET static void map(T* result, std::size_t n, F f, const In*... in) {               \
+			isa_map_body(result, n, f, in...) ;                                            \
+		}                                                                                      \
+		template <typename T>                                                                  \
+		TARGET static void masked_add(const T* a, const T* b, const bool* mask, T* result, std::size_t n) { \
+			isa_masked_add_body(a, b, mask, result, n) ;                                   \
+		}                                                                                      \
+		template <typename T, typename Pred>                                                   \
+		TARGET static int find_first(const T* data, std::size_t n, Pred pred) {                \
+			return isa_find_first_body(data, n, pred) ;                                    \
+		}                                                                                      \
+	} ;
+
+XBENCHMARK_ISA_KERNELS(sse42, )
+XBENCHMARK_ISA_KERNELS(avx2, XBENCHMARK_TARGET_AVX2)
+XBENCHMARK_ISA_KERNELS(avx512, XBENCHMARK_TARGET_AVX512)
+
+#undef XBENCHMARK_ISA_KERNELS
@@ -0,0 +1,213 @@
+#pragma once
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+
+// Hand-written AVX2 / AVX-512 BLAS1 kernels on float (and int32 comparisons), used as an
+// upper bound for the auto-vectorised loops and the library versions.
+//
+// An ISA is a struct of static functions on its register type : aligned / unaligned loads and
+// stores, masked loads and stores for the tail, arithmetic. The kernels are written once on
+// top of it :
+// - simd_map<ISA, Aligned, Unroll>(result, n, f, inputs...) : result[i] = f(inputs[i]...),
+//   Unroll registers per loop iteration, then single registers, then the last n % width
+//   elements with a masked load / store (no scalar loop)
+// - simd_less<ISA, Aligned, Unroll>(a, b, result, n) : result[i] = a[i] < b[i] as bool
+// Aligned = true uses aligned loads and stores : the arrays must be 64-byte aligned.
+//
+// Only the ISAs enabled at compile time are defined (-march=native, or -mavx2 -mfma -mbmi2 /
+// -mavx512f -mavx512bw -mavx512vl) : XBENCHMARK_HAS_AVX2, XBENCHMARK_HAS_AVX512.
+
+#if defined(__AVX2__) && defined(__FMA__) && defined(__BMI2__)
+#define XBENCHMARK_HAS_AVX2 1
+
+struct avx2_isa {
+	using reg = __m256 ;
+	using ireg = __m256i ;
+	using mask = __m256i ;
+	static constexpr std::size_t width = 8 ;
+
+	template <bool Aligned>
+	static reg load(const float* p) { return Aligned ? _mm256_load_ps(p) : _mm256_loadu_ps(p) ; }
+	template <bool Aligned>
+	static void store(float* p, reg v) {
+		if constexpr (Aligned) {
+			_mm256_store_ps(p, v) ;
+		} else {
+			_mm256_storeu_ps(p, v) ;
+		}
+	}
+	template <bool Aligned>
+	static ireg load(const std::int32_t* p) {
+		return Aligned ? _mm256_load_si256(reinterpret_cast<const __m256i*>(p)) : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) ;
+	}
+
+	// the first r lanes, 0 < r < width
+	static mask tail_mask(std::size_t r) {
+		return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(r)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)) ;
+	}
+	static reg load_masked(const float* p, mask m) { return _mm256_maskload_ps(p, m) ; }
+	static void store_masked(float* p, mask m, reg v) { _mm256_maskstore_ps(p, m, v) ; }
+	static ireg load_masked(const std::int32_t* p, mask m) { return _mm256_maskload_epi32(reinterpret_cast<const int*>(p), m) ; }
+
+	static reg set1(float x) { return _mm256_set1_ps(x) ; }
+	static reg add(reg a, reg b) { return _mm256_add_ps(a, b) ; }
+	static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b) ; }
+	static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b) ; }
+	static reg div(reg a, reg b) { return _mm256_div_ps(a, b) ; }
+	static reg fmadd(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c) ; }
+
+	// a < b, one bool (0 / 1) per lane : the 8-bit compare mask is spread over 8 bytes (pdep)
+	static void store_less(bool* out, ireg a, ireg b, std::size_t lanes = width) {
+		const unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)))) ;
+		const std::uint64_t bytes = _pdep_u64(bits, 0x0101010101010101ull) ;
+		std::memcpy(out, &bytes, lanes) ;
+	}
+};
+#endif
+
+
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+#define XBENCHMARK_HAS_AVX512 1
+
+struct avx512_isa {
+	using reg = __m512 ;
+	using ireg = __m512i ;
+	using mask = __mmask16 ;
+	static constexpr std::size_t width = 16 ;
+
+	template <bool Aligned>
+	static reg load(const float* p) { return Aligned ? _mm512_load_ps(p) : _mm512_loadu_ps(p) ; }
+	template <bool Aligned>
+	static void store(float* p, reg v) {
+		if constexpr (Aligned) {
+			_mm512_store_ps(p, v) ;
+		} else {
+			_mm512_storeu_ps(p, v) ;
+		}
+	}
+	template <bool Aligned>
+	static ireg load(const std::int32_t* p) { return Aligned ? _mm512_load_si512(p) : _mm512_loadu_si512(p) ; }
+
+	static mask tail_mask(std::size_t r) { return static_cast<mask>((1u << r) - 1) ; }
+	static reg load_masked(const float* p, mask m) { return _mm512_maskz_loadu_ps(m, p) ; }
+	static void store_masked(float* p, mask m, reg v) { _mm512_mask_storeu_ps(p, m, v) ; }
+	static ireg load_masked(const std::int32_t* p, mask m) { return _mm512_maskz_loadu_epi32(m, p) ; }
+
+	static reg set1(float x) { return _mm512_set1_ps(x) ; }
+	static reg add(reg a, reg b) { return _mm512_add_ps(a, b) ; }
+	static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b) ; }
+	static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b) ; }
+	static reg div(reg a, reg b) { return _mm512_div_ps(a, b) ; }
+	static reg fmadd(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c) ; }
+
+	// a < b, one bool (0 / 1) per lane : compare into a mask register, then a masked byte move
+	static void store_less(bool* out, ireg a, ireg b, std::size_t lanes = width) {
+		const __mmask16 less = _mm512_cmplt_epi32_mask(a, b) ;
+		const __m128i bytes = _mm_maskz_mov_epi8(less, _mm_set1_epi8(1)) ;
+		if (lanes == width) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes) ;
+		} else {
+			_mm_mask_storeu_epi8(out, tail_mask(lanes), bytes) ;
+		}
+	}
+};
+#endif
+
+
+// std::plus / minus / multiplies / divides on float registers
+template <typename ISA, typename Op>
+struct simd_op ;
+
+template <typename ISA>
+struct simd_op<ISA, std::plus<float>> {
+	static typename ISA::reg apply(typename ISA::reg a, typename ISA::reg b) { return ISA::add(a, b) ; }
+};
+template <typename ISA>
+struct simd_op<ISA, std::minus<float>> {
+	static typename ISA::reg apply(typename ISA::reg a, typename ISA::reg b) { return ISA::sub(a, b) ; }
+};
+template <typename ISA>
+struct simd_op<ISA, std::multiplies<float>> {
+	static typename ISA::reg apply(typename ISA::reg a, typename ISA::reg b) { return ISA::mul(a, b) ; }
+};
+template <typename ISA>
+struct simd_op<ISA, std::divides<float>> {
+	static typename ISA::reg apply(typename ISA::reg a, typename ISA::reg b) { return ISA::div(a, b) ; }
+};
+
+
+template <typename ISA, bool Aligned, std::size_t Unroll, typename F, typename... In>
+inline void simd_map(float* result, std::size_t n, F f, const In*... in) {
+	constexpr std::size_t width = ISA::width ;
+	std::size_t i = 0 ;
+	for (; i + Unroll * width <= n ; i += Unroll * width) {
+		typename ISA::reg r[Unroll] ;
+		for (std::size_t u = 0 ; u < Unroll ; u++) {
+			r[u] = f(ISA::template load<Aligned>(in + i + u * width)...) ;
+		}
+		for (std::size_t u = 0 ; u < Unroll ; u++) {
+			ISA::template store<Aligned>(result + i + u * width, r[u]) ;
+		}
+	}
+	for (; i + width <= n ; i += width) {
+		ISA::template store<Aligned>(result + i, f(ISA::template load<Aligned>(in + i)...)) ;
+	}
+	if (i < n) {
+		const typename ISA::mask m = ISA::tail_mask(n - i) ;
+		ISA::store_masked(result + i, m, f(ISA::load_masked(in + i, m)...)) ;
+	}
+}
+
+template <typename ISA, bool Aligned, std::size_t Unroll>
+inline void simd_less(const std::int32_t* a, const std::int32_t* b, bool* result, std::size_t n) {
+	constexpr std::size_t width = ISA::width ;
+	std::size_t i = 0 ;
+	for (; i + Unroll * width <= n ; i += Unroll * width) {
+		for (std::size_t u = 0 ; u < Unroll ; u++) {
+			ISA::store_less(result + i + u * width, ISA::template load<Aligned>(a + i + u * width), ISA::template load<Aligned>(b + i + u * width)) ;
+		}
+	}
+	for (; i + width <= n ; i += width) {
+		ISA::store_less(result + i, ISA::template load<Aligned>(a + i), ISA::template load<Aligned>(b + i)) ;
+	}
+	if (i < n) {
+		const typename ISA::mask m = ISA::tail_mask(n - i) ;
+		ISA::store_less(result + i, ISA::load_masked(a + i, m), ISA::load_masked(b + i, m), n - i) ;
+	}
+}
+
+
+// Array of the intrinsic benchmarks : 64-byte aligned, or shifted by one element when
+// Aligned is false, so that the unaligned kernels really run on data crossing cache lines.
+template <typename T>
+class simd_buffer {
+public:
+	simd_buffer(std::size_t n, bool aligned, T value) {
+		const std::size_t bytes = ((n + 1) * sizeof(T) + 63) / 64 * 64 ;
+		m_base = static_cast<T*>(std::aligned_alloc(64, bytes)) ;
+		if (m_base == nullptr) {
+			throw std::bad_alloc() ;
+		}
+		m_data = aligned ? m_base : m_base + 1 ;
+		for (std::size_t i = 0 ; i < n ; i++) {
+			m_data[i] = value ;
+		}
+	}
+
+	simd_buffer(const simd_buffer&) = delete ;
+	simd_buffer& operator=(const simd_buffer&) = delete ;
+
+	~simd_buffer() { std::free(m_base) ; }
+
+	T* data() { return m_data ; }
+
+private:
+	T* m_base ;
+	T* m_data ;
+};
@@ -0,0 +1,140 @@
+#pragma once
+#include <experimental/simd>
+
+#include <cstddef>
+#include <functional>
+
+// Portable SIMD kernels on std::experimental::simd (Parallelism TS 2, GCC 11 and later) :
+// the same source compiles to SSE / AVX / AVX-512 on x86 and NEON / SVE (fixed size) on ARM,
+// the register width is the one of native_simd<T> for the target given to the compiler.
+//
+// Full registers are loaded and stored with copy_from / copy_to, the last n % size()
+// elements through where(tail_mask, v), the portable form of masked loads and stores.
+namespace stdx = std::experimental ;
+
+template <typename T>
+using native_simd = stdx::native_simd<T> ;
+
+// mask of the first r lanes
+template <typename T>
+inline typename native_simd<T>::mask_type stdsimd_tail_mask(std::size_t r) {
+	const native_simd<T> lane([](auto i) { return static_cast<T>(static_cast<int>(i)) ; }) ;
+	return lane < static_cast<T>(r) ;
+}
+
+// std::plus<T> / minus / multiplies / divides / less applied to registers
+template <typename Op>
+struct stdsimd_op ;
+
+template <typename T>
+struct stdsimd_op<std::plus<T>> {
+	template <typename V>
+	V operator()(const V& a, const V& b) const { return a + b ; }
+};
+template <typename T>
+struct stdsimd_op<std::minus<T>> {
+	template <typename V>
+	V operator()(const V& a, const V& b) const { return a - b ; }
+};
+template <typename T>
+struct stdsimd_op<std::multiplies<T>> {
+	template <typename V>
+	V operator()(const V& a, const V& b) const { return a * b ; }
+};
+template <typename T>
+struct stdsimd_op<std::divides<T>> {
+	template <typename V>
+	V operator()(const V& a, const V& b) const { return a / b ; }
+};
+template <typename T>
+struct stdsimd_op<std::less<T>> {
+	template <typename V>
+	typename V::mask_type operator()(const V& a, const V& b) const { return a < b ; }
+};
+
+
+// result[i] = f(in[i]...), f taking and returning native_simd<T>
+template <typename T, typename F, typename... In>
+inline void stdsimd_map(T* result, std::size_t n, F f, const In*... in) {
+	using V = native_simd<T> ;
+	constexpr std::size_t width = V::size() ;
+	std::size_t i = 0 ;
+	for (; i + width <= n ; i += width) {
+		const V r = f(V(in + i, stdx::element_aligned)...) ;
+		r.copy_to(result + i, stdx::element_aligned) ;
+	}
+	if (i < n) {
+		const typename V::mask_type tail = stdsimd_tail_mask<T>(n - i) ;
+		auto load = [&](const T* p) {
+			V v(T(0)) ;
+			stdx::where(tail, v).copy_from(p, stdx::element_aligned) ;
+			return v ;
+		} ;
+		V r = f(load(in + i)...) ;
+		stdx::where(tail, r).copy_to(result + i, stdx::element_aligned) ;
+	}
+}
+
+// result[i] = cmp(a[i], b[i]) as bool, cmp returning a simd mask
+template <typename T, typename Cmp>
+inline void stdsimd_compare(const T* a, const T* b, bool* result, std::size_t n, Cmp cmp) {
+	using V = native_simd<T> ;
+	constexpr std::size_t width = V::size() ;
+	std::size_t i = 0 ;
+	for (; i + width <= n ; i += width) {
+		cmp(V(a + i, stdx::element_aligned), V(b + i, stdx::element_aligned)).copy_to(result + i, stdx::element_aligned) ;
+	}
+	if (i < n) {
+		const typename V::mask_type tail = stdsimd_tail_mask<T>(n - i) ;
+		V va(T(0)) ;
+		V vb(T(0)) ;
+		stdx::where(tail, va).copy_from(a + i, stdx::element_aligned) ;
+		stdx::where(tail, vb).copy_from(b + i, stdx::element_aligned) ;
+		const typename V::mask_type m = cmp(va, vb) ;
+		for (std::size_t k = 0 ; k < n - i ; k++) {
+			result[i + k] = m[k] ;
+		}
+	}
+}
+
+// result[i] = mask[i] ? a[i] + b[i] : result[i], the bool mask loaded as a simd mask
+template <typename T>
+inline void stdsimd_masked_add(const T* a, const T* b, const bool* mask, T* result, std::size_t n) {
+	using V = native_simd<T> ;
+	using M = typename V::mask_type ;
+	constexpr std::size_t width = V::size() ;
+	std::size_t i = 0 ;
+	for (; i + width <= n ; i += width) {
+		const M m(mask + i, stdx::element_aligned) ;
+		V r(result + i, stdx::element_aligned) ;
+		stdx::where(m, r) = V(a + i, stdx::element_aligned) + V(b + i, stdx::element_aligned) ;
+		r.copy_to(result + i, stdx::element_aligned) ;
+	}
+	for (; i < n ; i++) {
+		result[i] = mask[i] ? a[i] + b[i] : result[i] ;
+	}
+}
+
+// index of the first element for which pred(register) is set, -1 if none
+template <typename T, typename Pred>
+inline int stdsimd_find_first(const T* data, std::size_t n, Pred pred) {
+	using V = native_simd<T> ;
+	constexpr std::size_t width = V::size() ;
+	std::size_t i = 0 ;
+	for (; i + width <= n ; i += width) {
+		const typename V::mask_type m = pred(V(data + i, stdx::element_aligned)) ;
+		if (stdx::any_of(m)) {
+			return static_cast<int>(i + stdx::find_first_set(m)) ;
+		}
+	}
+	if (i < n) {
+		const typename V::mask_type tail = stdsimd_tail_mask<T>(n - i) ;
+		V v(T(0)) ;
+		stdx::where(tail, v).copy_from(data + i, stdx::element_aligned) ;
+		const typename V::mask_type m = pred(v) && tail ;
+		if (stdx::any_of(m)) {
+			return static_cast<int>(i + stdx::find_first_set(m)) ;
+		}
+	}
+	return -1 ;
+}
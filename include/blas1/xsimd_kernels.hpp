@@ -0,0 +1,75 @@
+#pragma once
+#include <xsimd/xsimd.hpp>
+
+#include <cstddef>
+#include <functional>
+
+// BLAS1 kernels written directly with xsimd::batch, without the xtensor expression and
+// assignment layer : same SIMD code generation as XTENSOR_USE_XSIMD, so the difference with the
+// BLAS1_*_xtensor benchmarks is the cost of xtensor itself (expression building, shape checks,
+// choice of the assignment loop).
+//
+// The loop is the one xtensor runs for a contiguous assignment : full batches with aligned
+// loads / stores, then a scalar loop for the last n % batch::size elements. The kernel f is a
+// generic lambda called on batches and on scalars.
+// Arrays must be aligned for the default xsimd architecture (64 bytes covers AVX-512).
+
+// std::plus<T> / minus / multiplies / divides / less, on batches and scalars
+template <typename Op>
+struct xsimd_op ;
+
+template <typename T>
+struct xsimd_op<std::plus<T>> {
+	template <typename V>
+	auto operator()(const V& a, const V& b) const { return a + b ; }
+};
+template <typename T>
+struct xsimd_op<std::minus<T>> {
+	template <typename V>
+	auto operator()(const V& a, const V& b) const { return a - b ; }
+};
+template <typename T>
+struct xsimd_op<std::multiplies<T>> {
+	template <typename V>
+	auto operator()(const V& a, const V& b) const { return a * b ; }
+};
+template <typename T>
+struct xsimd_op<std::divides<T>> {
+	template <typename V>
+	auto operator()(const V& a, const V& b) const { return a / b ; }
+};
+template <typename T>
+struct xsimd_op<std::less<T>> {
+	template <typename V>
+	auto operator()(const V& a, const V& b) const { return a < b ; }
+};
+
+
+// result[i] = f(in[i]...)
+template <typename T, typename F, typename... In>
+inline void xsimd_map(T* result, std::size_t n, F f, const In*... in) {
+	using batch = xsimd::batch<T> ;
+	constexpr std::size_t width = batch::size ;
+	const std::size_t vectorized = n - n % width ;
+	for (std::size_t i = 0 ; i < vectorized ; i += width) {
+		const batch r = f(batch::load_aligned(in + i)...) ;
+		r.store_aligned(result + i) ;
+	}
+	for (std::size_t i = vectorized ; i < n ; i++) {
+		result[i] = f(in[i]...) ;
+	}
+}
+
+// result[i] = cmp(a[i], b[i]), the batch_bool stored as bool
+template <typename T, typename Cmp>
+inline void xsimd_compare(const T* a, const T* b, bool* result, std::size_t n, Cmp cmp) {
+	using batch = xsimd::batch<T> ;
+	constexpr std::size_t width = batch::size ;
+	const std::size_t vectorized = n - n % width ;
+	for (std::size_t i = 0 ; i < vectorized ; i += width) {
+		cmp(batch::load_aligned(a + i), batch::load_aligned(b + i)).store_unaligned(result + i) ;
+	}
+	for (std::size_t i = vectorized ; i < n ; i++) {
+		result[i] = cmp(a[i], b[i]) ;
+	}
+}
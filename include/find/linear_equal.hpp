@@ -1,6 +1,12 @@
 #include <algorithm>
 #include <immintrin.h>
 
+#include <blas1/isa_kernels.hpp>
+
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+
 
 
 int find_equal_naive(int* vector, int size, int value){
@@ -45,6 +51,8 @@ int find_equal_std_find(int* vector, int size, int value){
 }
 
 
+// AVX2 whatever the build flags : check cpu_isa() before calling it
+XBENCHMARK_TARGET_AVX2
 int find_equal_intrinsic(int* vector, int size, int value){
         // experimental
         int index = -1 ;
@@ -71,3 +79,20 @@ int find_equal_intrinsic(int* vector, int size, int value){
         }
         return index ;
 }
+
+
+#ifdef XBENCHMARK_USE_STDSIMD
+// portable SIMD (std::experimental::simd) : one compare per native register, any_of then
+// find_first_set on the mask, masked last register
+int find_equal_stdsimd(int* vector, int size, int value){
+        return stdsimd_find_first(vector, size, [value](const native_simd<int>& v) { return v == value ; }) ;
+}
+#endif
+
+
+// plain loop compiled for each ISA level (include/blas1/isa_kernels.hpp) : find_equal_isa<L> is
+// the version of level L, dispatch_isa(active_isa(), ...) picks one at run time
+template <isa_level L>
+int find_equal_isa(int* vector, int size, int value){
+        return isa_kernels<L>::find_first(vector, size, [value](int x) { return x == value ; }) ;
+}
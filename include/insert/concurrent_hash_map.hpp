@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Lock-free open-addressing hash map (linear probing) of int keys and values.
+// A slot is claimed with a compare-and-swap on the key, then the value is written.
+// Fixed capacity (power of two, at least 2 * expected_size) : no concurrent resize.
+// Keys must be >= 0 : -1 marks an empty slot.
+class concurrent_hash_map {
+public:
+	explicit concurrent_hash_map(std::size_t expected_size) {
+		m_log_capacity = 4 ;
+		while ((std::size_t(1) << m_log_capacity) < 2 * expected_size) {
+			m_log_capacity++ ;
+		}
+		m_mask = (std::size_t(1) << m_log_capacity) - 1 ;
+		m_keys.reset(new std::atomic<int>[m_mask + 1]) ;
+		m_values.reset(new std::atomic<int>[m_mask + 1]) ;
+		clear() ;
+	}
+
+	// insert (key, value), or update the value if the key already exists.
+	// probes counts the slots visited after the first one, cas_failures the lost CAS.
+	bool insert(int key, int value, std::size_t& probes, std::size_t& cas_failures) {
+		std::size_t slot = hash(key) ;
+		while (true) {
+			int current = m_keys[slot].load(std::memory_order_acquire) ;
+			if (current == empty) {
+				if (m_keys[slot].compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+					m_values[slot].store(value, std::memory_order_relaxed) ;
+					return true ;
+				}
+				cas_failures++ ; // current now holds the winning key
+			}
+			if (current == key) {
+				m_values[slot].store(value, std::memory_order_relaxed) ;
+				return false ;
+			}
+			slot = (slot + 1) & m_mask ;
+			probes++ ;
+		}
+	}
+
+	// not thread-safe
+	void clear() {
+		for (std::size_t i = 0 ; i <= m_mask ; i++) {
+			m_keys[i].store(empty, std::memory_order_relaxed) ;
+		}
+	}
+
+	std::size_t capacity() const { return m_mask + 1 ; }
+
+private:
+	static constexpr int empty = -1 ;
+
+	std::unique_ptr<std::atomic<int>[]> m_keys ;
+	std::unique_ptr<std::atomic<int>[]> m_values ;
+	std::size_t m_mask ;
+	unsigned m_log_capacity ;
+
+	// Fibonacci hashing
+	std::size_t hash(int key) const {
+		return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)) * 11400714819323198485ull) >> (64 - m_log_capacity) ;
+	}
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Sorted set of integer cells stored as disjoint half-open intervals [start, end),
+// like the cell intervals of Samurai.
+//
+// Inserting cell x extends a neighbouring interval when x touches it, and merges
+// the two neighbours when x fills the hole between them : a new interval is only
+// created for an isolated cell. Erasing shrinks an interval, or splits it in two
+// when the cell is inside.
+template <typename T = int>
+class interval_set {
+public:
+	struct interval {
+		T start ;
+		T end ;
+	};
+
+	// return true if x was not already in the set
+	bool insert(const T& x) {
+		auto next = upper_bound(x) ; // first interval with start > x
+		if (next != m_intervals.begin()) {
+			auto prev = next - 1 ;
+			if (x < prev->end) {
+				return false ; // already inside
+			}
+			if (x == prev->end) {
+				prev->end++ ;
+				if (next != m_intervals.end() && next->start == prev->end) {
+					prev->end = next->end ; // fills the hole : merge
+					m_intervals.erase(next) ;
+				}
+				m_size++ ;
+				return true ;
+			}
+		}
+		if (next != m_intervals.end() && next->start == x + 1) {
+			next->start = x ;
+		} else {
+			m_intervals.insert(next, interval{x, x + 1}) ;
+		}
+		m_size++ ;
+		return true ;
+	}
+
+	// return true if x was in the set
+	bool erase(const T& x) {
+		auto next = upper_bound(x) ;
+		if (next == m_intervals.begin()) {
+			return false ;
+		}
+		auto it = next - 1 ;
+		if (x >= it->end) {
+			return false ;
+		}
+		if (it->start == x && it->end == x + 1) {
+			m_intervals.erase(it) ;
+		} else if (it->start == x) {
+			it->start++ ;
+		} else if (it->end == x + 1) {
+			it->end-- ;
+		} else {
+			T end = it->end ;
+			it->end = x ;
+			m_intervals.insert(next, interval{x + 1, end}) ; // split
+		}
+		m_size-- ;
+		return true ;
+	}
+
+	bool contains(const T& x) const {
+		auto next = std::upper_bound(m_intervals.begin(), m_intervals.end(), x,
+				[](const T& value, const interval& i) { return value < i.start ; }) ;
+		return next != m_intervals.begin() && x < (next - 1)->end ;
+	}
+
+	// in-order traversal of the cells : f(x)
+	template <typename F>
+	void for_each(F&& f) const {
+		for (const interval& i : m_intervals) {
+			for (T x = i.start ; x < i.end ; x++) {
+				f(x) ;
+			}
+		}
+	}
+
+	const std::vector<interval>& intervals() const { return m_intervals ; }
+	std::size_t size() const { return m_size ; }           // number of cells
+	std::size_t interval_count() const { return m_intervals.size() ; }
+	std::size_t memory() const { return m_intervals.capacity() * sizeof(interval) ; }
+
+	void clear() {
+		m_intervals.clear() ;
+		m_size = 0 ;
+	}
+
+private:
+	std::vector<interval> m_intervals ; // sorted and disjoint, never adjacent
+	std::size_t m_size = 0 ;
+
+	typename std::vector<interval>::iterator upper_bound(const T& x) {
+		return std::upper_bound(m_intervals.begin(), m_intervals.end(), x,
+				[](const T& value, const interval& i) { return value < i.start ; }) ;
+	}
+};
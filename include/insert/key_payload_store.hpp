@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Sorted key array + separate payload pool.
+//
+// The sorted array only holds (key, handle) pairs, where the handle is the index of
+// the payload in the pool. An insertion in the middle thus shifts 8 bytes per element
+// (for an int key) instead of the whole record. The pool is a std::deque, so the
+// payloads never move once inserted and handles stay valid.
+//
+// Payloads are stored in insertion order, which breaks locality for an in-order
+// traversal. compact() rebuilds the pool in key order to restore it.
+template <typename K, typename P>
+class key_payload_store {
+public:
+	using handle_type = std::uint32_t ;
+
+	struct entry {
+		K key ;
+		handle_type handle ;
+	};
+
+	std::size_t size() const { return m_entries.size() ; }
+
+	// insert (key, payload), or update the payload if the key already exists
+	// return true if a new element has been inserted
+	bool insert(const K& key, const P& payload) {
+		auto it = lower_bound(key) ;
+		if (it != m_entries.end() && it->key == key) {
+			m_pool[it->handle] = payload ;
+			return false ;
+		}
+		handle_type handle = static_cast<handle_type>(m_pool.size()) ;
+		m_pool.push_back(payload) ;
+		m_entries.insert(it, entry{key, handle}) ;
+		return true ;
+	}
+
+	// return a pointer on the payload associated to key, nullptr if not found
+	const P* find(const K& key) const {
+		auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key,
+				[](const entry& e, const K& value) { return e.key < value ; }) ;
+		if (it != m_entries.end() && it->key == key) {
+			return &m_pool[it->handle] ;
+		}
+		return nullptr ;
+	}
+
+	// in-order traversal : f(key, payload)
+	template <typename F>
+	void for_each(F&& f) const {
+		for (const entry& e : m_entries) {
+			f(e.key, m_pool[e.handle]) ;
+		}
+	}
+
+	// rebuild the pool in key order : handle i is then the i-th key
+	void compact() {
+		std::deque<P> pool ;
+		for (entry& e : m_entries) {
+			pool.push_back(std::move(m_pool[e.handle])) ;
+			e.handle = static_cast<handle_type>(pool.size() - 1) ;
+		}
+		m_pool.swap(pool) ;
+	}
+
+	void clear() {
+		m_entries.clear() ;
+		m_pool.clear() ;
+	}
+
+private:
+	std::vector<entry> m_entries ; // sorted by key
+	std::deque<P> m_pool ;         // payloads, in insertion order (key order after compact())
+
+	typename std::vector<entry>::iterator lower_bound(const K& key) {
+		return std::lower_bound(m_entries.begin(), m_entries.end(), key,
+				[](const entry& e, const K& value) { return e.key < value ; }) ;
+	}
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+// Steady-state workload on a pre-populated container : a mesh of N cells where, at
+// each step, some cells are refined (insert), some are coarsened (erase), and the
+// others are looked up or updated in between.
+//
+// The stream is simulated once on the set of live keys, so that every container
+// replays exactly the same operations : an insert always adds a new key, an erase,
+// a lookup or an update always targets a key that is in the container.
+
+enum class operation : std::uint8_t { insert = 0, erase, lookup, update } ;
+
+constexpr std::size_t operation_count = 4 ;
+
+inline const char* operation_name(operation op) {
+	switch (op) {
+		case operation::insert : return "insert" ;
+		case operation::erase :  return "erase" ;
+		case operation::lookup : return "lookup" ;
+		case operation::update : return "update" ;
+	}
+	return "unknown" ;
+}
+
+struct mixed_op {
+	operation type ;
+	int key ;
+};
+
+// percentages of each operation, their sum must be 100
+struct operation_mix {
+	int insert ;
+	int erase ;
+	int lookup ;
+	int update ;
+};
+
+struct mixed_workload {
+	std::vector<int> initial ;   // distinct keys of the pre-populated container
+	std::vector<mixed_op> ops ;
+};
+
+inline mixed_workload generate_mixed_workload(
+		std::size_t size,
+		std::size_t count,
+		operation_mix mix,
+		int key_range = 1 << 30,
+		std::uint32_t seed = 1234
+		) {
+	std::mt19937 gen(seed) ;
+	std::uniform_int_distribution<int> key_distrib(0, key_range - 1) ;
+	std::discrete_distribution<int> op_distrib({
+		static_cast<double>(mix.insert), static_cast<double>(mix.erase),
+		static_cast<double>(mix.lookup), static_cast<double>(mix.update)}) ;
+
+	mixed_workload workload ;
+	std::unordered_set<int> present ;
+	std::vector<int> live ;  // same keys as present, for uniform picks
+	present.reserve(size + count) ;
+	live.reserve(size + count) ;
+
+	auto fresh_key = [&]() {
+		int key ;
+		do {
+			key = key_distrib(gen) ;
+		} while (!present.insert(key).second) ;
+		live.push_back(key) ;
+		return key ;
+	};
+
+	while (live.size() < size) {
+		fresh_key() ;
+	}
+	workload.initial = live ;
+
+	workload.ops.reserve(count) ;
+	for (std::size_t i = 0 ; i < count ; i++) {
+		auto type = static_cast<operation>(op_distrib(gen)) ;
+		if (live.empty() && type != operation::insert) {
+			type = operation::insert ; // nothing left to erase or look up
+		}
+		if (type == operation::insert) {
+			workload.ops.push_back({type, fresh_key()}) ;
+			continue ;
+		}
+		std::uniform_int_distribution<std::size_t> index_distrib(0, live.size() - 1) ;
+		std::size_t index = index_distrib(gen) ;
+		int key = live[index] ;
+		if (type == operation::erase) {
+			present.erase(key) ;
+			live[index] = live.back() ;
+			live.pop_back() ;
+		}
+		workload.ops.push_back({type, key}) ;
+	}
+	return workload ;
+}
+
+
+// Latency samples of each operation type, in nanoseconds.
+class latency_recorder {
+public:
+	void record(operation op, double ns) {
+		m_samples[static_cast<std::size_t>(op)].push_back(ns) ;
+	}
+
+	std::size_t count(operation op) const {
+		return m_samples[static_cast<std::size_t>(op)].size() ;
+	}
+
+	double mean(operation op) const {
+		const std::vector<double>& samples = m_samples[static_cast<std::size_t>(op)] ;
+		if (samples.empty()) {
+			return 0.0 ;
+		}
+		double sum = 0.0 ;
+		for (double s : samples) {
+			sum += s ;
+		}
+		return sum / samples.size() ;
+	}
+
+	// q in [0, 1], sorts the samples in place
+	double percentile(operation op, double q) {
+		std::vector<double>& samples = m_samples[static_cast<std::size_t>(op)] ;
+		if (samples.empty()) {
+			return 0.0 ;
+		}
+		std::size_t rank = std::min(samples.size() - 1, static_cast<std::size_t>(q * samples.size())) ;
+		std::nth_element(samples.begin(), samples.begin() + rank, samples.end()) ;
+		return samples[rank] ;
+	}
+
+private:
+	std::array<std::vector<double>, operation_count> m_samples ;
+};
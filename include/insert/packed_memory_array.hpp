@@ -0,0 +1,215 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
+// Packed memory array (PMA) : sorted array with gaps.
+//
+// The storage is cut into segments of `segment_size` slots. Inside a segment, the
+// elements are packed on the left and the gaps are on the right, so a scan only
+// skips the tail of each segment. When a segment is full, we look for the smallest
+// enclosing window (2, 4, 8 ... segments) whose density is under its threshold and
+// spread its elements evenly. If even the whole array is too dense, the capacity
+// is doubled. This gives amortised O(log^2 n) element moves per insertion.
+//
+// Keys and values are stored in two separate arrays (SoA) to keep the key search
+// and the value scan contiguous.
+//
+// Invariant (no erase) : after the first insertion, every segment holds at least one
+// element. The growth threshold below guarantees size >= number of segments after
+// each full redistribution.
+template <typename K, typename V = K>
+class packed_memory_array {
+public:
+	packed_memory_array() {
+		resize_storage(min_capacity) ;
+	}
+
+	std::size_t size() const { return m_size ; }
+	std::size_t capacity() const { return m_keys.size() ; }
+
+	// insert (key, value), or update the value if the key already exists
+	// return true if a new element has been inserted
+	bool insert(const K& key, const V& value) {
+		if (m_size == 0) {
+			m_keys[0] = key ;
+			m_values[0] = value ;
+			m_counts[0] = 1 ;
+			m_size = 1 ;
+			return true ;
+		}
+		std::size_t seg = find_segment(key) ;
+		std::size_t begin = seg * m_segment_size ;
+		std::size_t end = begin + m_counts[seg] ;
+		std::size_t pos = std::lower_bound(m_keys.begin() + begin, m_keys.begin() + end, key) - m_keys.begin() ;
+		if (pos < end && m_keys[pos] == key) {
+			m_values[pos] = value ;
+			return false ;
+		}
+		if (m_counts[seg] == m_segment_size) {
+			rebalance(seg) ;
+			return insert(key, value) ; // the layout changed : search again
+		}
+		// shift right inside the segment only
+		std::copy_backward(m_keys.begin() + pos, m_keys.begin() + end, m_keys.begin() + end + 1) ;
+		std::copy_backward(m_values.begin() + pos, m_values.begin() + end, m_values.begin() + end + 1) ;
+		m_keys[pos] = key ;
+		m_values[pos] = value ;
+		m_counts[seg]++ ;
+		m_size++ ;
+		return true ;
+	}
+
+	// return a pointer on the value associated to key, nullptr if not found
+	const V* find(const K& key) const {
+		if (m_size == 0) {
+			return nullptr ;
+		}
+		std::size_t seg = find_segment(key) ;
+		std::size_t begin = seg * m_segment_size ;
+		std::size_t end = begin + m_counts[seg] ;
+		std::size_t pos = std::lower_bound(m_keys.begin() + begin, m_keys.begin() + end, key) - m_keys.begin() ;
+		if (pos < end && m_keys[pos] == key) {
+			return &m_values[pos] ;
+		}
+		return nullptr ;
+	}
+
+	// in-order traversal : f(key, value)
+	template <typename F>
+	void for_each(F&& f) const {
+		for (std::size_t seg = 0 ; seg < m_counts.size() ; seg++) {
+			std::size_t begin = seg * m_segment_size ;
+			std::size_t end = begin + m_counts[seg] ;
+			for (std::size_t i = begin ; i < end ; i++) {
+				f(m_keys[i], m_values[i]) ;
+			}
+		}
+	}
+
+	void clear() {
+		resize_storage(min_capacity) ;
+		m_size = 0 ;
+	}
+
+private:
+	static constexpr std::size_t min_capacity = 16 ;
+	static constexpr double leaf_density = 1.0 ;  // upper density threshold of a segment
+	static constexpr double root_density = 0.75 ; // upper density threshold of the whole array
+
+	std::vector<K> m_keys ;
+	std::vector<V> m_values ;
+	std::vector<std::size_t> m_counts ; // number of elements in each segment
+	std::vector<K> m_tmp_keys ;         // scratch buffers for rebalancing
+	std::vector<V> m_tmp_values ;
+	std::size_t m_segment_size = min_capacity ;
+	std::size_t m_size = 0 ;
+
+	// segment size : power of two around log2(capacity), at least 16
+	static std::size_t segment_size_for(std::size_t capacity) {
+		std::size_t log = 0 ;
+		while ((std::size_t(1) << log) < capacity) {
+			log++ ;
+		}
+		std::size_t s = min_capacity ;
+		while (s < log) {
+			s *= 2 ;
+		}
+		return std::min(s, capacity) ;
+	}
+
+	void resize_storage(std::size_t capacity) {
+		m_segment_size = segment_size_for(capacity) ;
+		m_keys.assign(capacity, K()) ;
+		m_values.assign(capacity, V()) ;
+		m_counts.assign(capacity / m_segment_size, 0) ;
+	}
+
+	// last segment whose first key is <= key (segment 0 otherwise)
+	std::size_t find_segment(const K& key) const {
+		std::size_t lo = 0 ;
+		std::size_t hi = m_counts.size() ;
+		while (hi - lo > 1) {
+			std::size_t mid = lo + (hi - lo) / 2 ;
+			if (m_keys[mid * m_segment_size] <= key) {
+				lo = mid ;
+			} else {
+				hi = mid ;
+			}
+		}
+		return lo ;
+	}
+
+	// density threshold of a window at a given level (0 = segment, height-1 = root)
+	double threshold(std::size_t level, std::size_t height) const {
+		if (height <= 1) {
+			return root_density ;
+		}
+		return leaf_density - (leaf_density - root_density) * double(level) / double(height - 1) ;
+	}
+
+	// spread the elements of segments [first, first + nseg) evenly, packed on the left
+	// of each segment. The elements must already be in m_tmp_keys / m_tmp_values.
+	void spread(std::size_t first, std::size_t nseg, std::size_t count) {
+		std::size_t per_seg = count / nseg ;
+		std::size_t extra = count % nseg ;
+		std::size_t src = 0 ;
+		for (std::size_t s = 0 ; s < nseg ; s++) {
+			std::size_t n = per_seg + (s < extra ? 1 : 0) ;
+			std::size_t dst = (first + s) * m_segment_size ;
+			std::copy(m_tmp_keys.begin() + src, m_tmp_keys.begin() + src + n, m_keys.begin() + dst) ;
+			std::copy(m_tmp_values.begin() + src, m_tmp_values.begin() + src + n, m_values.begin() + dst) ;
+			m_counts[first + s] = n ;
+			src += n ;
+		}
+	}
+
+	void gather(std::size_t first, std::size_t nseg) {
+		m_tmp_keys.clear() ;
+		m_tmp_values.clear() ;
+		for (std::size_t s = first ; s < first + nseg ; s++) {
+			std::size_t begin = s * m_segment_size ;
+			m_tmp_keys.insert(m_tmp_keys.end(), m_keys.begin() + begin, m_keys.begin() + begin + m_counts[s]) ;
+			m_tmp_values.insert(m_tmp_values.end(), m_values.begin() + begin, m_values.begin() + begin + m_counts[s]) ;
+		}
+	}
+
+	// make room in segment seg, which is full
+	void rebalance(std::size_t seg) {
+		std::size_t nseg_total = m_counts.size() ;
+		std::size_t height = 1 ;
+		while ((std::size_t(1) << (height - 1)) < nseg_total) {
+			height++ ;
+		}
+		std::size_t count = m_counts[seg] ;
+		std::size_t first = seg ;
+		std::size_t width = 1 ;
+		for (std::size_t level = 1 ; level < height ; level++) {
+			// grow the window to the aligned parent and add the sibling's elements
+			std::size_t parent_first = (seg / (2 * width)) * (2 * width) ;
+			std::size_t sibling = (parent_first == first) ? first + width : parent_first ;
+			for (std::size_t s = sibling ; s < sibling + width ; s++) {
+				count += m_counts[s] ;
+			}
+			first = parent_first ;
+			width *= 2 ;
+			if (double(count + 1) <= threshold(level, height) * double(width * m_segment_size)) {
+				gather(first, width) ;
+				spread(first, width, count) ;
+				return ;
+			}
+		}
+		grow() ;
+	}
+
+	// double the capacity until the root density is under its threshold
+	void grow() {
+		gather(0, m_counts.size()) ;
+		std::size_t capacity = m_keys.size() * 2 ;
+		while (double(m_size + 1) > root_density * double(capacity)) {
+			capacity *= 2 ;
+		}
+		resize_storage(capacity) ;
+		spread(0, m_counts.size(), m_size) ;
+	}
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <utils/spin_barrier.hpp>
+
+// Thread-local build followed by a parallel merge into one sorted vector.
+//
+// 1. each thread sorts its own chunk of keys (no sharing at all)
+// 2. thread 0 picks nthreads - 1 splitters from samples of the sorted chunks, and
+//    computes where each chunk is cut and where each partition starts in the output
+// 3. each thread merges its key interval from every chunk into its part of the output
+//
+// Like INSERT_vector_insert, duplicated keys are kept.
+class parallel_sorted_build {
+public:
+	parallel_sorted_build(int nthreads, std::size_t size)
+		: m_nthreads(nthreads),
+		  m_local(nthreads),
+		  m_scratch(nthreads),
+		  m_merged(nthreads),
+		  m_bounds(nthreads, std::vector<std::size_t>(nthreads + 1)),
+		  m_offsets(nthreads + 1),
+		  m_result(size) {}
+
+	// called by every thread of the benchmark with its chunk [begin, end)
+	void run(int thread, const int* begin, const int* end, spin_barrier& barrier) {
+		std::vector<int>& local = m_local[thread] ;
+		local.assign(begin, end) ;
+		std::sort(local.begin(), local.end()) ;
+		barrier.arrive_and_wait() ;
+
+		if (thread == 0) {
+			partition() ;
+		}
+		barrier.arrive_and_wait() ;
+
+		merge(thread) ;
+	}
+
+	const std::vector<int>& result() const { return m_result ; }
+
+private:
+	int m_nthreads ;
+	std::vector<std::vector<int>> m_local ;                // sorted chunk of each thread
+	std::vector<std::vector<int>> m_scratch ;              // merge buffers of each thread
+	std::vector<std::vector<int>> m_merged ;
+	std::vector<std::vector<std::size_t>> m_bounds ;      // m_bounds[chunk][partition] : first index of the partition in the chunk
+	std::vector<std::size_t> m_offsets ;                  // first index of each partition in the output
+	std::vector<int> m_samples ;
+	std::vector<int> m_result ;
+
+	void partition() {
+		m_samples.clear() ;
+		for (const std::vector<int>& local : m_local) {
+			for (int s = 1 ; s < m_nthreads && !local.empty() ; s++) {
+				m_samples.push_back(local[s * local.size() / m_nthreads]) ;
+			}
+		}
+		std::sort(m_samples.begin(), m_samples.end()) ;
+
+		for (int p = 0 ; p <= m_nthreads ; p++) {
+			m_offsets[p] = 0 ;
+		}
+		for (int c = 0 ; c < m_nthreads ; c++) {
+			const std::vector<int>& local = m_local[c] ;
+			m_bounds[c][0] = 0 ;
+			m_bounds[c][m_nthreads] = local.size() ;
+			for (int p = 1 ; p < m_nthreads ; p++) {
+				int splitter = m_samples.empty() ? std::numeric_limits<int>::max()
+				                                 : m_samples[p * m_samples.size() / m_nthreads] ;
+				m_bounds[c][p] = std::lower_bound(local.begin(), local.end(), splitter) - local.begin() ;
+			}
+			for (int p = 0 ; p < m_nthreads ; p++) {
+				m_offsets[p + 1] += m_bounds[c][p + 1] - m_bounds[c][p] ;
+			}
+		}
+		for (int p = 0 ; p < m_nthreads ; p++) {
+			m_offsets[p + 1] += m_offsets[p] ;
+		}
+	}
+
+	void merge(int p) {
+		std::vector<int>& merged = m_merged[p] ;
+		std::vector<int>& scratch = m_scratch[p] ;
+		merged.clear() ;
+		for (int c = 0 ; c < m_nthreads ; c++) {
+			auto first = m_local[c].begin() + m_bounds[c][p] ;
+			auto last = m_local[c].begin() + m_bounds[c][p + 1] ;
+			scratch.resize(merged.size() + (last - first)) ;
+			std::merge(merged.begin(), merged.end(), first, last, scratch.begin()) ;
+			merged.swap(scratch) ;
+		}
+		std::copy(merged.begin(), merged.end(), m_result.begin() + m_offsets[p]) ;
+	}
+};
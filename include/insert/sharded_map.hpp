@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// std::map split into shards, each one protected by its own mutex.
+// Shards are contiguous key intervals of [0, key_range) : the concatenation of the
+// shards is sorted, so we keep a global in-order traversal.
+// With a single shard, this is a std::map behind a global lock.
+template <typename V>
+class sharded_map {
+public:
+	sharded_map(long key_range, std::size_t nshards)
+		: m_key_range(key_range), m_shards(nshards) {}
+
+	// insert (key, value), or update the value if the key already exists.
+	// contended is incremented if the shard lock was already taken.
+	bool insert(int key, const V& value, std::size_t& contended) {
+		shard& s = m_shards[shard_index(key)] ;
+		std::unique_lock<std::mutex> lock(s.mutex, std::try_to_lock) ;
+		if (!lock.owns_lock()) {
+			contended++ ;
+			lock.lock() ;
+		}
+		return s.map.insert_or_assign(key, value).second ;
+	}
+
+	std::size_t size() const {
+		std::size_t n = 0 ;
+		for (const shard& s : m_shards) {
+			n += s.map.size() ;
+		}
+		return n ;
+	}
+
+	// in-order traversal : f(key, value) (not thread-safe)
+	template <typename F>
+	void for_each(F&& f) const {
+		for (const shard& s : m_shards) {
+			for (const auto& [key, value] : s.map) {
+				f(key, value) ;
+			}
+		}
+	}
+
+	void clear() {
+		for (shard& s : m_shards) {
+			s.map.clear() ;
+		}
+	}
+
+private:
+	// one shard per cache line to avoid false sharing between the mutexes
+	struct alignas(64) shard {
+		std::mutex mutex ;
+		std::map<int, V> map ;
+	};
+
+	long m_key_range ;
+	std::vector<shard> m_shards ;
+
+	std::size_t shard_index(int key) const {
+		return static_cast<std::size_t>(static_cast<long>(key) * static_cast<long>(m_shards.size()) / m_key_range) ;
+	}
+};
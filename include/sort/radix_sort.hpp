@@ -0,0 +1,150 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// Element of the key-value sorts
+template <typename K, typename V>
+struct key_value {
+	K key ;
+	V value ;
+};
+
+template <typename K, std::enable_if_t<std::is_integral_v<K>, int> = 0>
+inline K key_of(const K& x) { return x ; }
+
+template <typename K, typename V>
+inline K key_of(const key_value<K, V>& x) { return x.key ; }
+
+template <typename T>
+using key_type = decltype(key_of(std::declval<const T&>())) ;
+
+// Unsigned image of a key with the same order : the sign bit is flipped
+template <typename K>
+inline std::make_unsigned_t<K> radix_key(K key) {
+	using U = std::make_unsigned_t<K> ;
+	if constexpr (std::is_signed_v<K>) {
+		return static_cast<U>(key) ^ (U(1) << (8 * sizeof(K) - 1)) ;
+	} else {
+		return key ;
+	}
+}
+
+template <typename T>
+inline void insertion_sort(T* first, T* last) {
+	for (T* i = first + 1 ; i < last ; i++) {
+		T x = *i ;
+		T* j = i ;
+		for ( ; j > first && key_of(x) < key_of(*(j - 1)) ; j--) {
+			*j = *(j - 1) ;
+		}
+		*j = x ;
+	}
+}
+
+
+// LSD radix sort with digits of Bits bits, stable.
+// Each pass scatters the elements between data and buffer (n elements) : after an
+// odd number of passes the result is copied back into data. A pass is skipped when
+// every element has the same digit (common for small key ranges).
+template <int Bits, typename T>
+void lsd_radix_sort(T* data, std::size_t n, T* buffer) {
+	using K = key_type<T> ;
+	constexpr int key_bits = 8 * sizeof(K) ;
+	constexpr int passes = (key_bits + Bits - 1) / Bits ;
+	constexpr std::size_t radix = std::size_t(1) << Bits ;
+	constexpr auto mask = (std::make_unsigned_t<K>(1) << Bits) - 1 ;
+
+	// histograms of every pass in a single read of the input
+	std::array<std::array<std::size_t, radix>, passes> counts {} ;
+	for (std::size_t i = 0 ; i < n ; i++) {
+		auto key = radix_key(key_of(data[i])) ;
+		for (int p = 0 ; p < passes ; p++) {
+			counts[p][(key >> (p * Bits)) & mask]++ ;
+		}
+	}
+
+	T* from = data ;
+	T* to = buffer ;
+	for (int p = 0 ; p < passes ; p++) {
+		std::array<std::size_t, radix>& count = counts[p] ;
+		if (n > 0 && count[(radix_key(key_of(from[0])) >> (p * Bits)) & mask] == n) {
+			continue ;
+		}
+		std::size_t offset = 0 ;
+		for (std::size_t d = 0 ; d < radix ; d++) {
+			std::size_t c = count[d] ;
+			count[d] = offset ;
+			offset += c ;
+		}
+		for (std::size_t i = 0 ; i < n ; i++) {
+			to[count[(radix_key(key_of(from[i])) >> (p * Bits)) & mask]++] = from[i] ;
+		}
+		std::swap(from, to) ;
+	}
+	if (from != data) {
+		std::memcpy(data, from, n * sizeof(T)) ;
+	}
+}
+
+// auxiliary memory of lsd_radix_sort, in bytes
+template <int Bits, typename T>
+constexpr std::size_t lsd_radix_sort_memory(std::size_t n) {
+	constexpr int passes = (8 * sizeof(key_type<T>) + Bits - 1) / Bits ;
+	return n * sizeof(T) + passes * (std::size_t(1) << Bits) * sizeof(std::size_t) ;
+}
+
+
+// In-place MSD radix sort on bytes (American flag sort), not stable.
+// Buckets smaller than Cutoff elements are finished with an insertion sort.
+template <int Cutoff = 32, typename T>
+void msd_radix_sort(T* first, T* last, int shift = 8 * sizeof(key_type<T>) - 8) {
+	const std::size_t n = last - first ;
+	if (n < Cutoff) {
+		insertion_sort(first, last) ;
+		return ;
+	}
+	std::array<std::size_t, 256> count {} ;
+	for (T* i = first ; i < last ; i++) {
+		count[(radix_key(key_of(*i)) >> shift) & 0xFF]++ ;
+	}
+	std::array<std::size_t, 256> head ;
+	std::array<std::size_t, 256> tail ;
+	std::size_t offset = 0 ;
+	for (int d = 0 ; d < 256 ; d++) {
+		head[d] = offset ;
+		offset += count[d] ;
+		tail[d] = offset ;
+	}
+	// cycle each misplaced element to the head of its bucket
+	for (int d = 0 ; d < 256 ; d++) {
+		while (head[d] < tail[d]) {
+			T x = first[head[d]] ;
+			int digit = (radix_key(key_of(x)) >> shift) & 0xFF ;
+			while (digit != d) {
+				std::swap(x, first[head[digit]++]) ;
+				digit = (radix_key(key_of(x)) >> shift) & 0xFF ;
+			}
+			first[head[d]++] = x ;
+		}
+	}
+	if (shift == 0) {
+		return ;
+	}
+	T* bucket = first ;
+	for (int d = 0 ; d < 256 ; d++) {
+		if (count[d] > 1) {
+			msd_radix_sort<Cutoff>(bucket, bucket + count[d], shift - 8) ;
+		}
+		bucket += count[d] ;
+	}
+}
+
+// auxiliary memory of msd_radix_sort, in bytes : 3 tables of 256 counters per recursion level
+template <typename T>
+constexpr std::size_t msd_radix_sort_memory(std::size_t) {
+	return sizeof(key_type<T>) * 3 * 256 * sizeof(std::size_t) ;
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <immintrin.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// AVX2 merge sort of 32-bit integers.
+//
+// 1. blocks of 64 keys are loaded in 8 registers and sorted column-wise by a
+//    19-comparator sorting network (min / max), then transposed : 8 sorted runs of 8
+// 2. runs are merged 2 by 2 with a bitonic merge network of 2 x 8 keys in registers,
+//    until a single run remains
+//
+// The input is copied into a buffer padded with INT_MAX up to a multiple of 64 :
+// the kernels never handle partial registers. Runs ping-pong between 2 buffers.
+class simd_sort {
+public:
+	void sort(std::int32_t* data, std::size_t n) {
+		if (n < 2) {
+			return ;
+		}
+		const std::size_t padded = (n + 63) / 64 * 64 ;
+		m_a.resize(padded) ;
+		m_b.resize(padded) ;
+		std::memcpy(m_a.data(), data, n * sizeof(std::int32_t)) ;
+		std::fill(m_a.begin() + n, m_a.end(), INT_MAX) ;
+
+		for (std::size_t i = 0 ; i < padded ; i += 64) {
+			sort_block(m_a.data() + i) ;
+		}
+		std::int32_t* from = m_a.data() ;
+		std::int32_t* to = m_b.data() ;
+		for (std::size_t width = 8 ; width < padded ; width *= 2) {
+			for (std::size_t i = 0 ; i < padded ; i += 2 * width) {
+				if (i + width >= padded) {
+					std::memcpy(to + i, from + i, (padded - i) * sizeof(std::int32_t)) ;
+				} else {
+					merge(from + i, width, from + i + width, std::min(width, padded - i - width), to + i) ;
+				}
+			}
+			std::swap(from, to) ;
+		}
+		std::memcpy(data, from, n * sizeof(std::int32_t)) ;
+	}
+
+	// auxiliary memory, in bytes
+	std::size_t memory() const {
+		return (m_a.capacity() + m_b.capacity()) * sizeof(std::int32_t) ;
+	}
+
+private:
+	std::vector<std::int32_t> m_a ;
+	std::vector<std::int32_t> m_b ;
+
+	static inline void compare_exchange(__m256i& a, __m256i& b) {
+		__m256i min = _mm256_min_epi32(a, b) ;
+		b = _mm256_max_epi32(a, b) ;
+		a = min ;
+	}
+
+	// sorts a bitonic sequence of 8 keys
+	static inline __m256i bitonic_sort(__m256i v) {
+		__m256i p = _mm256_permute2x128_si256(v, v, 0x01) ;
+		v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xF0) ;
+		p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)) ;
+		v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xCC) ;
+		p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)) ;
+		v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xAA) ;
+		return v ;
+	}
+
+	// a and b sorted : a gets the 8 smallest keys, b the 8 largest, both sorted
+	static inline void bitonic_merge(__m256i& a, __m256i& b) {
+		const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0) ;
+		b = _mm256_permutevar8x32_epi32(b, reverse) ;
+		compare_exchange(a, b) ;
+		a = bitonic_sort(a) ;
+		b = bitonic_sort(b) ;
+	}
+
+	static inline void transpose(__m256i r[8]) {
+		__m256 t[8] ;
+		__m256 s[8] ;
+		for (int i = 0 ; i < 8 ; i += 2) {
+			t[i]     = _mm256_unpacklo_ps(_mm256_castsi256_ps(r[i]), _mm256_castsi256_ps(r[i + 1])) ;
+			t[i + 1] = _mm256_unpackhi_ps(_mm256_castsi256_ps(r[i]), _mm256_castsi256_ps(r[i + 1])) ;
+		}
+		for (int i = 0 ; i < 8 ; i += 4) {
+			s[i]     = _mm256_shuffle_ps(t[i],     t[i + 2], _MM_SHUFFLE(1, 0, 1, 0)) ;
+			s[i + 1] = _mm256_shuffle_ps(t[i],     t[i + 2], _MM_SHUFFLE(3, 2, 3, 2)) ;
+			s[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0)) ;
+			s[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2)) ;
+		}
+		for (int i = 0 ; i < 4 ; i++) {
+			r[i]     = _mm256_castps_si256(_mm256_permute2f128_ps(s[i], s[i + 4], 0x20)) ;
+			r[i + 4] = _mm256_castps_si256(_mm256_permute2f128_ps(s[i], s[i + 4], 0x31)) ;
+		}
+	}
+
+	// 64 keys -> 8 sorted runs of 8
+	static inline void sort_block(std::int32_t* block) {
+		__m256i r[8] ;
+		for (int i = 0 ; i < 8 ; i++) {
+			r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 8 * i)) ;
+		}
+		compare_exchange(r[0], r[2]) ; compare_exchange(r[1], r[3]) ; compare_exchange(r[4], r[6]) ; compare_exchange(r[5], r[7]) ;
+		compare_exchange(r[0], r[4]) ; compare_exchange(r[1], r[5]) ; compare_exchange(r[2], r[6]) ; compare_exchange(r[3], r[7]) ;
+		compare_exchange(r[0], r[1]) ; compare_exchange(r[2], r[3]) ; compare_exchange(r[4], r[5]) ; compare_exchange(r[6], r[7]) ;
+		compare_exchange(r[2], r[4]) ; compare_exchange(r[3], r[5]) ;
+		compare_exchange(r[1], r[4]) ; compare_exchange(r[3], r[6]) ;
+		compare_exchange(r[1], r[2]) ; compare_exchange(r[3], r[4]) ; compare_exchange(r[5], r[6]) ;
+		transpose(r) ;
+		for (int i = 0 ; i < 8 ; i++) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(block + 8 * i), r[i]) ;
+		}
+	}
+
+	// merges 2 sorted runs whose sizes are multiples of 8
+	static void merge(const std::int32_t* a, std::size_t na, const std::int32_t* b, std::size_t nb, std::int32_t* out) {
+		__m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)) ;
+		__m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)) ;
+		std::size_t ia = 8 ;
+		std::size_t ib = 8 ;
+		bitonic_merge(lo, hi) ;
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lo) ;
+		out += 8 ;
+		while (ia < na || ib < nb) {
+			const std::int32_t* next ;
+			if (ib >= nb || (ia < na && a[ia] <= b[ib])) {
+				next = a + ia ;
+				ia += 8 ;
+			} else {
+				next = b + ib ;
+				ib += 8 ;
+			}
+			lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next)) ;
+			bitonic_merge(lo, hi) ;
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lo) ;
+			out += 8 ;
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), hi) ;
+	}
+};
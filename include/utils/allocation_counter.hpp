@@ -0,0 +1,55 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Comptage des allocations sur le tas, activé avec -DXBENCHMARK_COUNT_ALLOCATIONS=ON :
+// la bibliothèque allocation_counter (src/utils/allocation_counter.cpp) remplace malloc,
+// calloc, realloc, free, aligned_alloc, posix_memalign, memalign et operator new / delete,
+// pour tout le processus et tous les threads. Les pages obtenues par mmap (huge_pages.hpp)
+// ne passent pas par là. Les compteurs sont atomiques : les temps mesurés avec la
+// bibliothèque ne sont pas comparables aux temps sans.
+//
+// Sans l'option, allocation_snapshot() renvoie des zéros et report_heap_allocations() ne fait rien.
+struct allocation_stats {
+	int64_t allocs = 0 ;         // nombre d'allocations
+	int64_t frees = 0 ;          // nombre de libérations
+	int64_t bytes = 0 ;          // octets demandés
+	int64_t live_bytes = 0 ;     // octets utilisables (malloc_usable_size) encore alloués
+	int64_t peak_bytes = 0 ;     // maximum de live_bytes depuis le dernier reset_allocation_peak()
+};
+
+#ifdef XBENCHMARK_COUNT_ALLOCATIONS
+allocation_stats allocation_snapshot() ;
+void reset_allocation_peak() ;
+#else
+inline allocation_stats allocation_snapshot() { return {} ; }
+inline void reset_allocation_peak() {}
+#endif
+
+// start() / stop() autour de la boucle du benchmark, comme rusage_counter
+class heap_counter {
+public:
+	void start() { m_start = allocation_snapshot() ; }
+	void stop() { m_stop = allocation_snapshot() ; }
+
+	int64_t allocs() const { return m_stop.allocs - m_start.allocs ; }
+	int64_t frees() const { return m_stop.frees - m_start.frees ; }
+	int64_t bytes() const { return m_stop.bytes - m_start.bytes ; }
+
+private:
+	allocation_stats m_start ;
+	allocation_stats m_stop ;
+};
+
+// Compteurs : allocs et alloc_bytes par itération (allocations faites dans la boucle mesurée,
+// par exemple les temporaires de xt::eval ou d'une expression Eigen)
+inline void report_heap_allocations(benchmark::State& state, const heap_counter& counter) {
+#ifdef XBENCHMARK_COUNT_ALLOCATIONS
+	const double iterations = static_cast<double>(state.iterations()) ;
+	state.counters["allocs"] = counter.allocs() / iterations ;
+	state.counters["alloc_bytes"] = benchmark::Counter(counter.bytes() / iterations, benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024) ;
+#else
+	(void)state ;
+	(void)counter ;
+#endif
+}
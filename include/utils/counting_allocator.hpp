@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+
+// std::allocator qui compte les allocations (compteur global, non thread-safe).
+// Sert à rapporter le nombre d'allocations évitées par un container.
+struct allocation_counter {
+	inline static std::size_t allocations = 0 ;
+	inline static std::size_t bytes = 0 ;
+
+	static void reset() {
+		allocations = 0 ;
+		bytes = 0 ;
+	}
+};
+
+template <typename T>
+struct counting_allocator : std::allocator<T> {
+	using value_type = T ;
+
+	template <typename U>
+	struct rebind { using other = counting_allocator<U> ; } ;
+
+	counting_allocator() = default ;
+	template <typename U>
+	counting_allocator(const counting_allocator<U>&) {}
+
+	T* allocate(std::size_t n) {
+		allocation_counter::allocations++ ;
+		allocation_counter::bytes += n * sizeof(T) ;
+		return std::allocator<T>::allocate(n) ;
+	}
+
+	void deallocate(T* p, std::size_t n) {
+		std::allocator<T>::deallocate(p, n) ;
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&) { return true ; }
+template <typename T, typename U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&) { return false ; }
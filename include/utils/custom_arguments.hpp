@@ -1,5 +1,6 @@
 #pragma once
 #include <benchmark/benchmark.h>
+#include <vector>
 
 // Déclaration avec valeurs par défaut basées sur des macros
 void CustomArguments(
@@ -10,3 +11,11 @@ void CustomArguments(
     int threshold2 = 4096
 );
 
+// Tailles générées par CustomArguments, pour composer des arguments multiples
+std::vector<int> CustomSizes(
+    int start = 1,
+    int end = 1000000,
+    int threshold1 = 1024,
+    int threshold2 = 4096
+);
+
@@ -0,0 +1,104 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+
+// Choix du jeu d'instructions à l'exécution, pour les noyaux multiversionnés.
+//
+// Niveaux :
+// - sse42  : x86-64-v2 (SSE4.2, POPCNT)
+// - avx2   : x86-64-v3 (AVX2, FMA, BMI2)
+// - avx512 : x86-64-v4 (AVX-512 F, BW, VL, DQ)
+//
+// Un noyau multiversionné est compilé une fois par niveau : la version sse42 avec les options
+// de la compilation, les autres avec les attributs XBENCHMARK_TARGET_AVX2 / AVX512. Un attribut
+// target ne fait qu'ajouter des instructions : une version n'est réellement de son niveau que si
+// la compilation ne vise pas plus haut (isa_baseline()). Avec -DXBENCHMARK_PORTABLE=ON
+// (-march=x86-64-v2), les trois niveaux sont dans le même binaire, qui tourne partout.
+//
+// Le niveau utilisé par défaut est celui du processeur (cpuid), que la variable d'environnement
+// XBENCHMARK_ISA (sse42, avx2 ou avx512) peut plafonner : XBENCHMARK_ISA=avx2 force les
+// versions AVX2 sur une machine AVX-512.
+
+enum class isa_level : int { sse42 = 0, avx2, avx512 } ;
+
+#define XBENCHMARK_TARGET_AVX2 __attribute__((target("avx2,fma,bmi,bmi2,lzcnt,popcnt")))
+#define XBENCHMARK_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,avx2,fma,bmi,bmi2,lzcnt,popcnt")))
+
+template <isa_level L>
+using isa_constant = std::integral_constant<isa_level, L> ;
+
+inline const char* isa_name(isa_level level) {
+	switch (level) {
+		case isa_level::sse42 :  return "sse42" ;
+		case isa_level::avx2 :   return "avx2" ;
+		case isa_level::avx512 : return "avx512" ;
+	}
+	return "unknown" ;
+}
+
+// niveau garanti par les options de compilation (-march)
+constexpr isa_level isa_baseline() {
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__AVX512DQ__)
+	return isa_level::avx512 ;
+#elif defined(__AVX2__) && defined(__FMA__) && defined(__BMI2__)
+	return isa_level::avx2 ;
+#else
+	return isa_level::sse42 ;
+#endif
+}
+
+// niveau du processeur
+inline isa_level cpu_isa() {
+	static const isa_level level = [] {
+		__builtin_cpu_init() ;
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+		    && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq")) {
+			return isa_level::avx512 ;
+		}
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("bmi2")) {
+			return isa_level::avx2 ;
+		}
+		return isa_level::sse42 ;
+	}() ;
+	return level ;
+}
+
+// niveau des noyaux dispatchés : celui du processeur, plafonné par XBENCHMARK_ISA, jamais
+// sous le niveau de compilation
+inline isa_level active_isa() {
+	static const isa_level level = [] {
+		isa_level forced = cpu_isa() ;
+		const char* env = std::getenv("XBENCHMARK_ISA") ;
+		const std::string name = env ? env : "" ;
+		for (isa_level l : {isa_level::sse42, isa_level::avx2, isa_level::avx512}) {
+			if (name == isa_name(l)) {
+				forced = l ;
+			}
+		}
+		return std::max(std::min(forced, cpu_isa()), isa_baseline()) ;
+	}() ;
+	return level ;
+}
+
+// nullptr si la version de niveau L peut être mesurée, sinon la raison
+inline const char* isa_unavailable(isa_level level) {
+	if (level < isa_baseline()) {
+		return "ISA below the compilation baseline (build with XBENCHMARK_PORTABLE)" ;
+	}
+	if (level > active_isa()) {
+		return "ISA not supported by the CPU or above XBENCHMARK_ISA" ;
+	}
+	return nullptr ;
+}
+
+// appelle f(isa_constant<level>()) : le niveau devient un paramètre template
+template <typename F>
+decltype(auto) dispatch_isa(isa_level level, F&& f) {
+	switch (level) {
+		case isa_level::avx512 : return f(isa_constant<isa_level::avx512>()) ;
+		case isa_level::avx2 :   return f(isa_constant<isa_level::avx2>()) ;
+		default :                return f(isa_constant<isa_level::sse42>()) ;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+// Générateur de flux de clés pour les benchmarks d'insertion.
+// Les clés sont générées AVANT la boucle chronométrée, avec une graine fixe :
+// le même flux est rejoué d'un run à l'autre et on ne mesure que le container.
+enum class key_distribution : int {
+	uniform = 0,    // uniforme dans [0, key_range)
+	sorted,         // uniforme puis triée par ordre croissant
+	reverse,        // uniforme puis triée par ordre décroissant
+	zipf,           // loi de Zipf (exposant 1) : les petites clés sont très fréquentes
+	clustered,      // rafales de 64 clés voisines autour d'une base aléatoire
+	amr_refinement  // raffinement : une zone de cellules grossières produit une rafale de 2^d fils contigus
+};
+
+const char* key_distribution_name(key_distribution distribution);
+
+// Génère count clés dans [0, key_range) suivant la distribution demandée
+std::vector<int> generate_keys(
+    key_distribution distribution,
+    std::size_t count,
+    int key_range = 10000,
+    std::uint32_t seed = 1234
+);
+
+// Arguments (size, stream, range) : balayage de taille de CustomArguments
+// pour chaque distribution et chaque intervalle de clés demandés.
+// Les arguments sont nommés, on peut donc filtrer avec --benchmark_filter='stream:4'
+void KeyStreamArguments(
+    benchmark::internal::Benchmark* b,
+    const std::vector<key_distribution>& distributions,
+    const std::vector<int>& key_ranges = {10000},
+    int start = 1,
+    int end = 1000000,
+    int threshold1 = 1024,
+    int threshold2 = 4096
+);
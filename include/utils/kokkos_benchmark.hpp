@@ -0,0 +1,44 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <Kokkos_Core.hpp>
+
+#include <string>
+
+// Outils communs aux benchmarks Kokkos.
+//
+// Les noyaux sont templatés sur l'espace d'exécution (Kokkos::Serial, Kokkos::OpenMP) : les
+// Views sont créées dans cet espace (mémoire HostSpace pour les deux), les parallel_for /
+// parallel_reduce utilisent RangePolicy<Space>. Un benchmark n'est enregistré que si son espace
+// est compilé dans Kokkos (KOKKOS_ENABLE_SERIAL, KOKKOS_ENABLE_OPENMP).
+//
+// Le nombre de threads de l'espace OpenMP est fixé au lancement : OMP_NUM_THREADS ou
+// --kokkos-num-threads=N. Les benchmarks sont enregistrés avec UseRealTime() : le temps CPU
+// ne compte que le thread principal.
+
+// libellé : nom de l'espace et nombre de threads
+template <typename Space>
+std::string kokkos_label() {
+	return std::string(Space::name()) + "/" + std::to_string(Space().concurrency()) ;
+}
+
+// parallel_for n'est pas bloquant en général : le temps d'un noyau va jusqu'au fence
+template <typename Space>
+void kokkos_fence() {
+	Space().fence() ;
+}
+
+// main() avec Kokkos initialisé avant Google Benchmark (Kokkos retire ses options --kokkos-*
+// de argv) et finalisé à la sortie. Remplace BENCHMARK_MAIN() dans les fichiers qui
+// enregistrent des benchmarks Kokkos.
+#define XBENCHMARK_KOKKOS_MAIN()                                            \
+	int main(int argc, char** argv) {                                   \
+		Kokkos::ScopeGuard kokkos(argc, argv) ;                     \
+		benchmark::Initialize(&argc, argv) ;                        \
+		if (benchmark::ReportUnrecognizedArguments(argc, argv)) {   \
+			return 1 ;                                          \
+		}                                                           \
+		benchmark::RunSpecifiedBenchmarks() ;                       \
+		benchmark::Shutdown() ;                                     \
+		return 0 ;                                                  \
+	}                                                                   \
+	int main(int, char**)
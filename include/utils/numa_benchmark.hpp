@@ -0,0 +1,156 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <utils/spin_barrier.hpp>
+#include <allocation/huge_pages.hpp>
+#include <allocation/numa.hpp>
+
+// Tableaux partagés par les threads d'un benchmark multi-threadé, placés selon une numa_policy.
+// Pages de 4 KB, alignées sur une page et jamais touchées avant le placement.
+template <typename T>
+struct numa_shared {
+	spin_barrier barrier ;
+	std::atomic<int> users ;  // le dernier thread à partir libère les tableaux
+	std::size_t size ;
+	std::vector<T*> arrays ;
+
+	numa_shared(int threads, std::size_t size, std::size_t count)
+		: barrier(threads), users(threads), size(size) {
+		for (std::size_t k = 0 ; k < count ; k++) {
+			arrays.push_back(page_alloc<T>(size, page_mode::small, 4096)) ;
+		}
+	}
+
+	~numa_shared() {
+		for (T* array : arrays) {
+			page_free(array) ;
+		}
+	}
+};
+
+
+// Côté thread d'un benchmark NUMA : range(1) = numa_policy, range(2) = thread_placement.
+// Le constructeur épingle le thread, le thread 0 crée les tableaux, puis chaque thread fait
+// sa part du premier contact (first touch) selon la politique ; le dernier thread à sortir
+// du destructeur libère tout (pas le thread 0 : les autres peuvent encore lire la barrière). Le découpage [first, last) tombe sur des frontières de page,
+// le même pour le placement et pour la boucle de calcul.
+template <typename T>
+class numa_thread {
+public:
+	numa_thread(benchmark::State& state, std::atomic<numa_shared<T>*>& shared, std::size_t size, std::initializer_list<T> values)
+		: m_shared(shared),
+		  m_thread(state.thread_index()),
+		  m_policy(static_cast<numa_policy>(state.range(1))),
+		  m_placement(static_cast<thread_placement>(state.range(2))),
+		  m_cpu(numa_topology::get().cpu(m_placement, m_thread)),
+		  m_pin(m_cpu),
+		  m_node(numa_topology::get().node_of_cpu(m_cpu)) {
+		const std::size_t page = 4096 / sizeof(T) ;
+		const std::size_t pages = (size + page - 1) / page ;
+		m_first = std::min(size, m_thread * pages / state.threads() * page) ;
+		m_last = std::min(size, (m_thread + 1) * pages / state.threads() * page) ;
+
+		if (m_thread == 0) {
+			m_shared.store(new numa_shared<T>(state.threads(), size, values.size()), std::memory_order_release) ;
+		}
+		while (m_shared.load(std::memory_order_acquire) == nullptr) {
+			std::this_thread::yield() ;
+		}
+		numa_shared<T>* arrays = m_shared.load(std::memory_order_acquire) ;
+		std::size_t k = 0 ;
+		for (T value : values) {
+			first_touch(arrays->arrays[k++], size, value) ;
+		}
+		arrays->barrier.arrive_and_wait() ;
+	}
+
+	numa_thread(const numa_thread&) = delete ;
+	numa_thread& operator=(const numa_thread&) = delete ;
+
+	~numa_thread() {
+		numa_shared<T>* arrays = m_shared.load(std::memory_order_acquire) ;
+		arrays->barrier.arrive_and_wait() ;
+		if (arrays->users.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			m_shared.store(nullptr, std::memory_order_release) ;
+			delete arrays ;
+		}
+	}
+
+	T* array(std::size_t k) const { return m_shared.load(std::memory_order_relaxed)->arrays[k] ; }
+	std::size_t first() const { return m_first ; }
+	std::size_t last() const { return m_last ; }
+
+	// bytes_per_element : octets lus + écrits par élément de la boucle de calcul.
+	// Compteurs : débit total (bytes_per_second), débit des threads de chaque nœud (node<k>_bw),
+	// fraction des pages du thread situées sur un autre nœud (remote_pages, sur 64 pages au plus).
+	void report(benchmark::State& state, std::size_t bytes_per_element) const {
+		const double bytes = static_cast<double>(state.iterations() * (m_last - m_first) * bytes_per_element) ;
+		state.SetBytesProcessed(static_cast<int64_t>(bytes)) ;
+		state.SetItemsProcessed(state.iterations() * (m_last - m_first)) ;
+		for (int node = 0 ; node < numa_topology::get().nodes() ; node++) {
+			state.counters["node" + std::to_string(node) + "_bw"] = benchmark::Counter(node == m_node ? bytes : 0.0, benchmark::Counter::kIsRate, benchmark::Counter::OneK::kIs1024) ;
+		}
+		const std::size_t pages = std::min<std::size_t>(64, (m_last - m_first) * sizeof(T) / 4096) ;
+		if (pages > 0) {
+			std::size_t remote = 0 ;
+			for (int node : numa_page_nodes(array(0) + m_first, pages)) {
+				remote += node != m_node ;
+			}
+			state.counters["remote_pages"] = benchmark::Counter(static_cast<double>(remote) / pages, benchmark::Counter::kAvgThreads) ;
+		}
+		if (m_thread == 0) {
+			state.SetLabel(std::string(numa_policy_name(m_policy)) + "/" + thread_placement_name(m_placement)) ;
+		}
+	}
+
+private:
+	std::atomic<numa_shared<T>*>& m_shared ;
+	const std::size_t m_thread ;
+	const numa_policy m_policy ;
+	const thread_placement m_placement ;
+	const int m_cpu ;
+	thread_pin m_pin ;
+	const int m_node ;
+	std::size_t m_first ;
+	std::size_t m_last ;
+
+	void first_touch(T* data, std::size_t size, T value) {
+		switch (m_policy) {
+			case numa_policy::serial_first_touch :
+				if (m_thread == 0) {
+					std::fill(data, data + size, value) ;
+				}
+				break ;
+			case numa_policy::parallel_first_touch :
+				std::fill(data + m_first, data + m_last, value) ;
+				break ;
+			case numa_policy::interleave :
+				if (m_thread == 0) {
+					numa_interleave(data, size * sizeof(T)) ;
+					std::fill(data, data + size, value) ;
+				}
+				break ;
+			case numa_policy::local_bind :
+				if (m_last > m_first) {
+					numa_bind(data + m_first, (m_last - m_first) * sizeof(T), m_node) ;
+				}
+				std::fill(data + m_first, data + m_last, value) ;
+				break ;
+		}
+	}
+};
+
+
+// Arguments des benchmarks NUMA : size x numa_policy x thread_placement
+inline void NumaArguments(benchmark::internal::Benchmark* b, const std::vector<int64_t>& sizes) {
+	b->ArgNames({"size", "policy", "placement"}) ;
+	b->ArgsProduct({sizes, {0, 1, 2, 3}, {0, 1}}) ;
+}
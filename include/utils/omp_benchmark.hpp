@@ -0,0 +1,116 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Noyaux BLAS1 multi-threadés avec OpenMP.
+//
+// Le tableau est découpé en blocs de chunk éléments (arrondi au multiple de 64 supérieur :
+// chaque bloc commence sur une ligne de cache, les chargements alignés restent valides), les
+// blocs sont distribués aux threads par un parallel for schedule(runtime) : static, dynamic
+// ou guided selon omp_set_schedule. chunk = 0 : un bloc par thread (n / threads).
+//
+// Arguments : range(0) = taille, range(1) = threads, range(2) = chunk (voir OmpArguments).
+//
+// Compteurs :
+// - bytes_per_second : bande passante (lectures + écritures)
+// - speedup          : temps du noyau séquentiel (le même corps sur [0, n), sans OpenMP) sur
+//                      le temps parallèle ; < 1 : le multi-threading est une perte nette
+// - efficiency       : speedup / threads
+// Le temps séquentiel est mesuré avant la boucle chronométrée. Les benchmarks doivent être
+// enregistrés avec UseRealTime().
+
+inline const char* omp_schedule_name(omp_sched_t schedule) {
+	switch (schedule) {
+		case omp_sched_static :  return "static" ;
+		case omp_sched_dynamic : return "dynamic" ;
+		case omp_sched_guided :  return "guided" ;
+		default :                return "auto" ;
+	}
+}
+
+class omp_run {
+public:
+	omp_run(benchmark::State& state, omp_sched_t schedule)
+	  : m_threads(static_cast<int>(state.range(1))), m_chunk(static_cast<std::size_t>(state.range(2))), m_schedule(schedule) {}
+
+	int threads() const { return m_threads ; }
+
+	// body(first, last) sur des blocs de [0, n), répartis sur threads() threads
+	template <typename Body>
+	void parallel_for(std::size_t n, Body&& body) const {
+		const std::size_t block = block_size(n) ;
+		const std::int64_t blocks = static_cast<std::int64_t>((n + block - 1) / block) ;
+		omp_set_schedule(m_schedule, 1) ;
+		#pragma omp parallel for schedule(runtime) num_threads(m_threads)
+		for (std::int64_t b = 0 ; b < blocks ; b++) {
+			const std::size_t first = static_cast<std::size_t>(b) * block ;
+			body(first, std::min(n, first + block)) ;
+		}
+	}
+
+	// temps moyen de body(0, n) sans OpenMP : au moins 3 appels et 10 ms, après un appel à vide
+	template <typename Body>
+	void measure_serial(std::size_t n, Body&& body) {
+		using clock = std::chrono::steady_clock ;
+		body(0, n) ;
+		std::size_t calls = 0 ;
+		const clock::time_point start = clock::now() ;
+		clock::duration elapsed {} ;
+		while (calls < 3 || elapsed < std::chrono::milliseconds(10)) {
+			body(0, n) ;
+			benchmark::ClobberMemory() ;
+			calls++ ;
+			elapsed = clock::now() - start ;
+		}
+		m_serial_seconds = std::chrono::duration<double>(elapsed).count() / calls ;
+	}
+
+	// les compteurs de taux sont divisés par le temps réel mesuré : speedup = temps
+	// séquentiel total / temps parallèle total
+	void report(benchmark::State& state, std::size_t n, std::size_t bytes_per_element) const {
+		state.SetItemsProcessed(state.iterations() * n) ;
+		state.SetBytesProcessed(state.iterations() * n * bytes_per_element) ;
+		const double serial = m_serial_seconds * state.iterations() ;
+		state.counters["speedup"] = benchmark::Counter(serial, benchmark::Counter::kIsRate) ;
+		state.counters["efficiency"] = benchmark::Counter(serial / m_threads, benchmark::Counter::kIsRate) ;
+		state.SetLabel(omp_schedule_name(m_schedule)) ;
+	}
+
+private:
+	std::size_t block_size(std::size_t n) const {
+		const std::size_t chunk = m_chunk > 0 ? m_chunk : (n + m_threads - 1) / m_threads ;
+		return std::max<std::size_t>(64, (chunk + 63) / 64 * 64) ;
+	}
+
+	const int m_threads ;
+	const std::size_t m_chunk ;
+	const omp_sched_t m_schedule ;
+	double m_serial_seconds = 0 ;
+};
+
+
+// Arguments des benchmarks OpenMP : size x threads x chunk. Tailles : puissances de 2 de 2^8
+// à 2^24 (le seuil de rentabilité du multi-threading), threads : 1, 2, 4... jusqu'au nombre
+// de coeurs.
+inline void OmpArguments(benchmark::internal::Benchmark* b, const std::vector<int64_t>& chunks) {
+	std::vector<int64_t> sizes ;
+	for (int64_t size = 1 << 8 ; size <= (1 << 24) ; size *= 2) {
+		sizes.push_back(size) ;
+	}
+	const int64_t cores = std::max(1u, std::thread::hardware_concurrency()) ;
+	std::vector<int64_t> threads ;
+	for (int64_t t = 1 ; t < cores ; t *= 2) {
+		threads.push_back(t) ;
+	}
+	threads.push_back(cores) ;
+	b->ArgNames({"size", "threads", "chunk"}) ;
+	b->ArgsProduct({sizes, threads, chunks}) ;
+	b->UseRealTime() ;
+}
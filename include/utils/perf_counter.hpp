@@ -0,0 +1,67 @@
+#pragma once
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+// Compteur matériel via perf_event_open, pour le thread appelant.
+// Si le noyau refuse (perf_event_paranoid, conteneur, machine virtuelle), available() est faux
+// et le benchmark ne rapporte simplement pas le compteur.
+class perf_counter {
+public:
+	perf_counter(std::uint32_t type, std::uint64_t config) {
+		perf_event_attr attr ;
+		std::memset(&attr, 0, sizeof(attr)) ;
+		attr.size = sizeof(attr) ;
+		attr.type = type ;
+		attr.config = config ;
+		attr.disabled = 1 ;
+		attr.exclude_kernel = 1 ;
+		attr.exclude_hv = 1 ;
+		m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0)) ;
+	}
+
+	perf_counter(const perf_counter&) = delete ;
+	perf_counter& operator=(const perf_counter&) = delete ;
+
+	~perf_counter() {
+		if (m_fd >= 0) {
+			close(m_fd) ;
+		}
+	}
+
+	bool available() const { return m_fd >= 0 ; }
+
+	void start() {
+		if (m_fd >= 0) {
+			ioctl(m_fd, PERF_EVENT_IOC_RESET, 0) ;
+			ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0) ;
+		}
+	}
+
+	void stop() {
+		if (m_fd >= 0) {
+			ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0) ;
+		}
+	}
+
+	std::uint64_t value() const {
+		std::uint64_t count = 0 ;
+		if (m_fd >= 0 && read(m_fd, &count, sizeof(count)) != sizeof(count)) {
+			count = 0 ;
+		}
+		return count ;
+	}
+
+private:
+	int m_fd = -1 ;
+};
+
+// défauts de TLB de données sur les lectures
+inline perf_counter dtlb_load_misses() {
+	return perf_counter(PERF_TYPE_HW_CACHE,
+			PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)) ;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <unistd.h>
+
+#include <cstddef>
+#include <fstream>
+
+// Mémoire résidente du processus (RSS), en octets : 2e champ de /proc/self/statm, en pages.
+// 0 si le fichier n'est pas lisible.
+inline std::size_t resident_bytes() {
+	std::ifstream file("/proc/self/statm") ;
+	std::size_t size = 0 ;
+	std::size_t resident = 0 ;
+	file >> size >> resident ;
+	return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) ;
+}
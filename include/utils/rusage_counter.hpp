@@ -0,0 +1,37 @@
+#pragma once
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <benchmark/benchmark.h>
+
+// Défauts de page et temps CPU utilisateur / système du thread appelant, via
+// getrusage(RUSAGE_THREAD). start() / stop() autour de la boucle du benchmark : les deux
+// appels sont hors de la boucle, ils ne changent pas le temps mesuré.
+class rusage_counter {
+public:
+	void start() { getrusage(RUSAGE_THREAD, &m_start) ; }
+	void stop() { getrusage(RUSAGE_THREAD, &m_stop) ; }
+
+	long minor_faults() const { return m_stop.ru_minflt - m_start.ru_minflt ; }
+	long major_faults() const { return m_stop.ru_majflt - m_start.ru_majflt ; }
+	double user_seconds() const { return seconds(m_stop.ru_utime) - seconds(m_start.ru_utime) ; }
+	double system_seconds() const { return seconds(m_stop.ru_stime) - seconds(m_start.ru_stime) ; }
+
+private:
+	rusage m_start {} ;
+	rusage m_stop {} ;
+
+	static double seconds(const timeval& t) { return t.tv_sec + 1e-6 * t.tv_usec ; }
+};
+
+// Compteurs : minor_faults et major_faults par itération, sys_fraction = part du temps CPU
+// passée dans le noyau (défauts de page, mise à zéro des pages, mmap / munmap).
+inline void report_faults(benchmark::State& state, const rusage_counter& counter) {
+	const double iterations = static_cast<double>(state.iterations()) ;
+	state.counters["minor_faults"] = counter.minor_faults() / iterations ;
+	state.counters["major_faults"] = counter.major_faults() / iterations ;
+	const double cpu = counter.user_seconds() + counter.system_seconds() ;
+	if (cpu > 0.0) {
+		state.counters["sys_fraction"] = counter.system_seconds() / cpu ;
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Passage d'une taille connue à l'exécution (state.range(0)) à un paramètre de template :
+// f est appelée avec std::integral_constant<std::size_t, n>, pour 1 <= n <= Max.
+// Un test par taille possible, fait une seule fois, hors de la boucle mesurée.
+// Retourne false si n est hors de [1, Max].
+template <std::size_t... I, typename F>
+bool dispatch_size(std::size_t n, F&& f, std::index_sequence<I...>) {
+	return ((n == I + 1 ? (f(std::integral_constant<std::size_t, I + 1>{}), true) : false) || ...) ;
+}
+
+template <std::size_t Max, typename F>
+bool dispatch_size(std::size_t n, F&& f) {
+	return dispatch_size(n, std::forward<F>(f), std::make_index_sequence<Max>{}) ;
+}
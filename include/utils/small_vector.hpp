@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Vecteur avec stockage interne de N éléments : pas d'allocation tant que size() <= N,
+// puis repli sur le tas (capacité doublée) comme std::vector.
+// Pensé pour les petites listes par cellule (voisins, enfants) de 2 à 8 éléments.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_vector {
+	using traits = std::allocator_traits<Allocator> ;
+
+public:
+	using value_type = T ;
+	using size_type = std::size_t ;
+	using iterator = T* ;
+	using const_iterator = const T* ;
+
+	small_vector() = default ;
+
+	small_vector(size_type count, const T& value) {
+		reserve(count) ;
+		std::uninitialized_fill_n(m_data, count, value) ;
+		m_size = count ;
+	}
+
+	small_vector(std::initializer_list<T> values) {
+		reserve(values.size()) ;
+		std::uninitialized_copy(values.begin(), values.end(), m_data) ;
+		m_size = values.size() ;
+	}
+
+	small_vector(const small_vector& other) {
+		reserve(other.m_size) ;
+		std::uninitialized_copy(other.begin(), other.end(), m_data) ;
+		m_size = other.m_size ;
+	}
+
+	small_vector(small_vector&& other) noexcept {
+		move_from(std::move(other)) ;
+	}
+
+	small_vector& operator=(const small_vector& other) {
+		if (this != &other) {
+			clear() ;
+			reserve(other.m_size) ;
+			std::uninitialized_copy(other.begin(), other.end(), m_data) ;
+			m_size = other.m_size ;
+		}
+		return *this ;
+	}
+
+	small_vector& operator=(small_vector&& other) noexcept {
+		if (this != &other) {
+			release() ;
+			move_from(std::move(other)) ;
+		}
+		return *this ;
+	}
+
+	~small_vector() { release() ; }
+
+	void push_back(const T& value) { emplace_back(value) ; }
+	void push_back(T&& value) { emplace_back(std::move(value)) ; }
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args) {
+		if (m_size == m_capacity) {
+			grow(2 * m_capacity) ;
+		}
+		T* element = ::new (static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...) ;
+		m_size++ ;
+		return *element ;
+	}
+
+	void pop_back() {
+		m_size-- ;
+		m_data[m_size].~T() ;
+	}
+
+	void reserve(size_type capacity) {
+		if (capacity > m_capacity) {
+			grow(capacity) ;
+		}
+	}
+
+	void clear() {
+		std::destroy_n(m_data, m_size) ;
+		m_size = 0 ;
+	}
+
+	T& operator[](size_type i) { return m_data[i] ; }
+	const T& operator[](size_type i) const { return m_data[i] ; }
+
+	T* data() { return m_data ; }
+	const T* data() const { return m_data ; }
+	iterator begin() { return m_data ; }
+	iterator end() { return m_data + m_size ; }
+	const_iterator begin() const { return m_data ; }
+	const_iterator end() const { return m_data + m_size ; }
+
+	size_type size() const { return m_size ; }
+	size_type capacity() const { return m_capacity ; }
+	bool empty() const { return m_size == 0 ; }
+
+	// vrai si les éléments sont dans le stockage interne (aucune allocation)
+	bool is_inline() const { return m_data == inline_data() ; }
+
+private:
+	alignas(T) unsigned char m_inline[N * sizeof(T)] ;
+	T* m_data = inline_data() ;
+	size_type m_size = 0 ;
+	size_type m_capacity = N ;
+	Allocator m_allocator ;
+
+	T* inline_data() { return std::launder(reinterpret_cast<T*>(m_inline)) ; }
+	const T* inline_data() const { return std::launder(reinterpret_cast<const T*>(m_inline)) ; }
+
+	void grow(size_type capacity) {
+		capacity = std::max<size_type>(capacity, 1) ;
+		T* data = traits::allocate(m_allocator, capacity) ;
+		std::uninitialized_move(m_data, m_data + m_size, data) ;
+		std::destroy_n(m_data, m_size) ;
+		if (!is_inline()) {
+			traits::deallocate(m_allocator, m_data, m_capacity) ;
+		}
+		m_data = data ;
+		m_capacity = capacity ;
+	}
+
+	void release() {
+		clear() ;
+		if (!is_inline()) {
+			traits::deallocate(m_allocator, m_data, m_capacity) ;
+		}
+		m_data = inline_data() ;
+		m_capacity = N ;
+	}
+
+	// other est laissé vide : on vole son tampon s'il est sur le tas, sinon on déplace les éléments
+	void move_from(small_vector&& other) {
+		if (other.is_inline()) {
+			std::uninitialized_move(other.begin(), other.end(), m_data) ;
+			m_size = other.m_size ;
+			other.clear() ;
+		} else {
+			m_data = other.m_data ;
+			m_size = other.m_size ;
+			m_capacity = other.m_capacity ;
+			other.m_data = other.inline_data() ;
+			other.m_size = 0 ;
+			other.m_capacity = N ;
+		}
+	}
+};
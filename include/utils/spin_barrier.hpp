@@ -0,0 +1,27 @@
+#pragma once
+#include <atomic>
+#include <thread>
+
+// Barrière réutilisable pour synchroniser les threads d'un benchmark multi-threadé
+// (std::barrier n'existe qu'en C++20). Les threads en attente font un yield.
+class spin_barrier {
+public:
+	explicit spin_barrier(int count) : m_count(count) {}
+
+	void arrive_and_wait() {
+		int phase = m_phase.load(std::memory_order_acquire) ;
+		if (m_waiting.fetch_add(1, std::memory_order_acq_rel) == m_count - 1) {
+			m_waiting.store(0, std::memory_order_relaxed) ;
+			m_phase.fetch_add(1, std::memory_order_release) ;
+		} else {
+			while (m_phase.load(std::memory_order_acquire) == phase) {
+				std::this_thread::yield() ;
+			}
+		}
+	}
+
+private:
+	const int m_count ;
+	std::atomic<int> m_waiting {0} ;
+	std::atomic<int> m_phase {0} ;
+};
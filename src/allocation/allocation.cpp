@@ -1,5 +1,15 @@
 #include <benchmark/benchmark.h>
+#include <sys/mman.h>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <malloc.h>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <thread>
 
 #include <functional>             
 #include <type_traits>           
@@ -15,7 +25,19 @@
 #include <xtensor/xmath.hpp>
 #endif
 
+#ifdef XBENCHMARK_USE_KOKKOS
+#include <utils/kokkos_benchmark.hpp>
+#endif
+
 #include <utils/custom_arguments.hpp>
+#include <utils/small_vector.hpp>
+#include <allocation/arena.hpp>
+#include <allocation/huge_pages.hpp>
+#include <allocation/default_init_allocator.hpp>
+#include <allocation/thread_cache_pool.hpp>
+#include <utils/spin_barrier.hpp>
+#include <utils/rusage_counter.hpp>
+#include <utils/resident_memory.hpp>
 int min = 1 ;
 int max = 1000000 ;
 int threshold1 = 1024 ;
@@ -26,14 +48,20 @@ const int MS = 4 ; // Min_size of arrays
 const int RM = 128 ; /// RangeMultiplier
 const int PS = 21 ; // pow size
 
+int ncores = std::max(1u, std::thread::hardware_concurrency()) ;
+
 
 // Note : I cant just use Operations like std::plus<> to reduce code size because I can't 
 // achieve to use it with XTensor in limited time.
 // So I decided to badly duplicate code for now ...
 
+// Counters minor_faults / major_faults (per iteration) and sys_fraction (include/utils/rusage_counter.hpp) :
+// above the malloc mmap threshold, every iteration pays one page fault per 4 KB page.
 template <typename T, typename Op>
 void ALLOC_raw(benchmark::State& state) {
 	const int vector_size = state.range(0);  // Vector size defined by benchmark range
+	rusage_counter faults ;
+	faults.start() ;
 	for (auto _ : state) {
 		T* vec = static_cast<T*>(std::malloc(vector_size * sizeof(T)));
 		for (int i = 0 ; i < vector_size; i++){
@@ -42,7 +70,9 @@ void ALLOC_raw(benchmark::State& state) {
 		benchmark::DoNotOptimize(vec); // compiler artifice 
 		free(vec);
 	}
+	faults.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
 }
 
 template <typename T, typename Op>
@@ -51,28 +81,533 @@ void ALLOC_aligned(benchmark::State& state) {
 	Op operation ; 
 	constexpr std::size_t alignment = 64; 
 
+	rusage_counter faults ;
+	faults.start() ;
 	for (auto _ : state) {
-		T* vec = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));		
+		// aligned_alloc, or 4 KB / huge pages according to XBENCHMARK_PAGES
+		T* vec = default_page_alloc<T>(vector_size, alignment);
 		for (int i = 0 ; i < vector_size ; i++){
 			vec[i] = 1.0 ; 
 		}
 		benchmark::DoNotOptimize(vec); // Prevent compiler optimizations
-		free(vec) ; 
+		default_page_free(vec) ; 
+	}
+	faults.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+}
+
+
+// Allocation + first touch + release of large arrays in 4 KB pages (small), transparent
+// huge pages (huge) or reserved huge pages (hugetlb) : the first touch costs one page
+// fault per page, 512 times fewer with 2 MB pages.
+template <typename T, page_mode Mode>
+void ALLOC_pages(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	rusage_counter faults ;
+	faults.start() ;
+	for (auto _ : state) {
+		T* vec = page_alloc<T>(vector_size, Mode);
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec);
+		page_free(vec) ;
+	}
+	faults.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+	T* vec = page_alloc<T>(vector_size, Mode);
+	state.counters["page_mode"] = static_cast<int>(allocated_page_mode(vec)) ;
+	page_free(vec) ;
+}
+
+
+// Splitting allocation, page faults and fill on large arrays (4 KB pages, no THP) :
+// - ALLOC_mmap          : mmap + fill (one fault per page, the kernel zeroes each page) + munmap
+// - ALLOC_mmap_populate : mmap, MADV_NOHUGEPAGE, then madvise(MADV_POPULATE_WRITE) maps and zeroes every
+//                         page in one call (touch loop before Linux 5.14), no fault in the fill
+// - ALLOC_dontneed      : buffer mapped once, madvise(MADV_DONTNEED) after each fill : the faults
+//                         and the zeroing come back at each iteration, but no mmap / munmap
+// - ALLOC_reused        : buffer mapped and touched once, the loop is the fill alone
+// ALLOC_dontneed - ALLOC_reused is the kernel cost (faults + zeroing), ALLOC_mmap - ALLOC_dontneed
+// the cost of the system calls.
+// MAP_POPULATE is not used : it faults the pages in before MADV_NOHUGEPAGE, under THP=always
+// the 2 MB aligned ranges would already be huge pages.
+template <typename T>
+T* map_array(std::size_t n) {
+	void* p = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) ;
+	if (p == MAP_FAILED) {
+		throw std::bad_alloc() ;
+	}
+#ifdef MADV_NOHUGEPAGE
+	madvise(p, n * sizeof(T), MADV_NOHUGEPAGE) ;
+#endif
+	return static_cast<T*>(p) ;
+}
+
+// prefault of the pages, after map_array : MADV_POPULATE_WRITE, or one write per 4 KB page when
+// the kernel does not know it (EINVAL before Linux 5.14)
+inline void populate_array(void* p, std::size_t bytes) {
+#ifdef MADV_POPULATE_WRITE
+	if (madvise(p, bytes, MADV_POPULATE_WRITE) == 0) {
+		return ;
+	}
+#endif
+	volatile char* page = static_cast<volatile char*>(p) ;
+	for (std::size_t offset = 0 ; offset < bytes ; offset += 4096) {
+		page[offset] = 0 ;
+	}
+}
+
+template <typename T>
+void ALLOC_mmap(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	rusage_counter faults ;
+	faults.start() ;
+	for (auto _ : state) {
+		T* vec = map_array<T>(vector_size) ;
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec);
+		munmap(vec, vector_size * sizeof(T)) ;
+	}
+	faults.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+}
+
+template <typename T>
+void ALLOC_mmap_populate(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	rusage_counter faults ;
+	faults.start() ;
+	for (auto _ : state) {
+		T* vec = map_array<T>(vector_size) ;
+		populate_array(vec, vector_size * sizeof(T)) ;
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec);
+		munmap(vec, vector_size * sizeof(T)) ;
+	}
+	faults.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+}
+
+template <typename T>
+void ALLOC_dontneed(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	T* vec = map_array<T>(vector_size) ;
+	rusage_counter faults ;
+	faults.start() ;
+	for (auto _ : state) {
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec);
+		madvise(vec, vector_size * sizeof(T), MADV_DONTNEED) ;
 	}
+	faults.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+	munmap(vec, vector_size * sizeof(T)) ;
 }
 
+template <typename T>
+void ALLOC_reused(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	T* vec = map_array<T>(vector_size) ;
+	for (int i = 0 ; i < vector_size ; i++){
+		vec[i] = 0.0 ;
+	}
+	rusage_counter faults ;
+	faults.start() ;
+	for (auto _ : state) {
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec);
+		benchmark::ClobberMemory();
+	}
+	faults.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+	munmap(vec, vector_size * sizeof(T)) ;
+}
+
+// Bump-pointer arena created outside of the loop and reset at each iteration :
+// an allocation only moves a pointer, no call to malloc in steady state.
+template <typename T, typename Op>
+void ALLOC_arena(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	arena pool(vector_size * sizeof(T)) ;
+	for (auto _ : state) {
+		T* vec = pool.allocate<T>(vector_size) ;
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec);
+		pool.reset() ;
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
 
 template <typename T, typename Op>
 void ALLOC_std_vector(benchmark::State& state) {
 	const int vector_size = state.range(0);  // Vector size defined by benchmark range
+	rusage_counter faults ;
+	faults.start() ;
 	for (auto _ : state) {
 		std::vector<T> vec(vector_size, 1);
 		benchmark::DoNotOptimize(vec); // compiler artifice 
 	}
+	faults.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_faults(state, faults) ;
+}
+
+// Vector(n) then the fill loop, as when a kernel writes into a freshly sized vector :
+// std::vector zero-fills first (two passes), uninitialized_vector does not (one pass).
+template <typename T, typename Vector>
+void ALLOC_vector_fill(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	for (auto _ : state) {
+		Vector vec(vector_size);
+		for (int i = 0 ; i < vector_size ; i++){
+			vec[i] = 1.0 ;
+		}
+		benchmark::DoNotOptimize(vec.data());
+	}
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// std::vector on the arena (arena_allocator) : deallocate does nothing, the memory comes back at reset
+template <typename T, typename Op>
+void ALLOC_arena_std_vector(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	arena pool(vector_size * sizeof(T)) ;
+	arena_allocator<T> allocator(pool) ;
+	for (auto _ : state) {
+		{
+			std::vector<T, arena_allocator<T>> vec(vector_size, 1, allocator);
+			benchmark::DoNotOptimize(vec.data());
+		}
+		pool.reset() ;
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// small_vector<T, N> : inline storage of N elements, heap allocation beyond.
+// allocations : allocations per construction (0 while size <= N, 1 otherwise),
+// allocations_avoided : compared to std::vector, which allocates as soon as it is not empty.
+template <typename T, std::size_t N>
+void ALLOC_small_vector(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	bool heap = false ;
+	for (auto _ : state) {
+		small_vector<T, N> vec(vector_size, 1);
+		benchmark::DoNotOptimize(vec.data());
+		heap = !vec.is_inline() ;
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["allocations"] = heap ? 1 : 0 ;
+	state.counters["allocations_avoided"] = (vector_size > 0 && !heap) ? 1 : 0 ;
+}
+
+// Multi-threaded churn : each thread allocates a batch of blocks of random sizes (8 bytes to
+// max_bytes), writes them, then frees them, as solver threads allocating temporaries at the
+// same time. Backends, one object per thread :
+struct malloc_backend {
+	void* allocate(std::size_t bytes) { return std::malloc(bytes) ; }
+	void deallocate(void* p) { std::free(p) ; }
+	void end_batch() {}
+};
+
+// thread-caching size-class pool (include/allocation/thread_cache_pool.hpp)
+struct pool_backend {
+	void* allocate(std::size_t bytes) { return thread_cache_pool::instance().allocate(bytes) ; }
+	void deallocate(void* p) { thread_cache_pool::instance().deallocate(p) ; }
+	void end_batch() {}
+};
+
+// one arena per thread : no free, reset at the end of the batch
+struct arena_backend {
+	arena pool {1 << 20} ;
+	void* allocate(std::size_t bytes) { return pool.allocate(bytes, 16) ; }
+	void deallocate(void*) {}
+	void end_batch() { pool.reset() ; }
+};
+
+const int churn_batch = 256 ; // blocks per batch and per thread
+
+std::vector<std::size_t> churn_sizes(int thread, std::size_t max_bytes) {
+	std::mt19937 gen(1234 + thread) ;
+	std::uniform_int_distribution<std::size_t> distrib(8, max_bytes) ;
+	std::vector<std::size_t> sizes(churn_batch) ;
+	for (std::size_t& size : sizes) {
+		size = distrib(gen) ;
+	}
+	return sizes ;
+}
+
+// State shared by the threads of one run : thread 0 creates it, the last thread to leave
+// deletes it (not thread 0 : the others may still be reading the barrier).
+struct churn_state {
+	spin_barrier barrier ;
+	std::atomic<int> users ;
+	std::vector<std::vector<void*>> blocks ;  // batch of each thread, for cross-thread free
+
+	explicit churn_state(int threads)
+		: barrier(threads), users(threads), blocks(threads, std::vector<void*>(churn_batch)) {}
+};
+
+churn_state* join_churn(benchmark::State& state, std::atomic<churn_state*>& shared) {
+	if (state.thread_index() == 0) {
+		shared.store(new churn_state(state.threads()), std::memory_order_release) ;
+	}
+	while (shared.load(std::memory_order_acquire) == nullptr) {
+		std::this_thread::yield() ;
+	}
+	return shared.load(std::memory_order_acquire) ;
+}
+
+void leave_churn(std::atomic<churn_state*>& shared, churn_state* churn) {
+	churn->barrier.arrive_and_wait() ;
+	if (churn->users.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		shared.store(nullptr, std::memory_order_release) ;
+		delete churn ;
+	}
+}
+
+// Throughput scaling : thread 0 measures the wall time of the whole loop, the rate is compared
+// to the 1-thread run of the same benchmark and max_bytes (efficiency = 1 : perfect scaling).
+void report_churn_scaling(benchmark::State& state, std::map<long, double>& reference, double elapsed) {
+	double rate = static_cast<double>(state.iterations()) * churn_batch * state.threads() / elapsed ;
+	if (state.threads() == 1) {
+		reference[state.range(0)] = rate ;
+	}
+	state.counters["alloc_rate"] = rate ;
+	auto it = reference.find(state.range(0)) ;
+	if (it != reference.end()) {
+		state.counters["efficiency"] = rate / (state.threads() * it->second) ;
+	}
+}
+
+template <typename Backend>
+void ALLOC_churn(benchmark::State& state) {
+	static std::atomic<churn_state*> shared {nullptr} ;
+	static std::map<long, double> reference ;
+	churn_state* churn = join_churn(state, shared) ;
+	Backend backend ;
+	const std::vector<std::size_t> sizes = churn_sizes(state.thread_index(), state.range(0)) ;
+	std::vector<void*> blocks(churn_batch) ;
+	auto start = std::chrono::steady_clock::now() ;
+	for (auto _ : state) {
+		for (int k = 0 ; k < churn_batch ; k++) {
+			blocks[k] = backend.allocate(sizes[k]) ;
+			static_cast<char*>(blocks[k])[0] = 1 ;
+		}
+		benchmark::DoNotOptimize(blocks.data()) ;
+		for (int k = 0 ; k < churn_batch ; k++) {
+			backend.deallocate(blocks[k]) ;
+		}
+		backend.end_batch() ;
+	}
+	state.SetItemsProcessed(state.iterations() * churn_batch);
+	churn->barrier.arrive_and_wait() ;
+	if (state.thread_index() == 0) {
+		report_churn_scaling(state, reference, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()) ;
+	}
+	leave_churn(shared, churn) ;
+}
+
+
+// Cross-thread free : at each iteration every thread allocates a batch, then frees the batch
+// allocated by its neighbour (thread t frees the blocks of thread t - 1). Cross = false frees its
+// own batch with the same barriers, as reference. Counters alloc_ns and free_ns : time per block
+// of each phase, barriers excluded. With one thread both patterns are the same.
+template <typename Backend, bool Cross>
+void ALLOC_free_pattern(benchmark::State& state) {
+	static std::atomic<churn_state*> shared {nullptr} ;
+	const int thread = state.thread_index() ;
+	churn_state* cross = join_churn(state, shared) ;
+	const int victim = Cross ? (thread + state.threads() - 1) % state.threads() : thread ;
+	Backend backend ;
+	const std::vector<std::size_t> sizes = churn_sizes(thread, state.range(0)) ;
+	double alloc_time = 0.0 ;
+	double free_time = 0.0 ;
+	for (auto _ : state) {
+		auto start = std::chrono::steady_clock::now() ;
+		for (int k = 0 ; k < churn_batch ; k++) {
+			void* p = backend.allocate(sizes[k]) ;
+			static_cast<char*>(p)[0] = 1 ;
+			cross->blocks[thread][k] = p ;
+		}
+		auto middle = std::chrono::steady_clock::now() ;
+		cross->barrier.arrive_and_wait() ;
+		auto resume = std::chrono::steady_clock::now() ;
+		for (int k = 0 ; k < churn_batch ; k++) {
+			backend.deallocate(cross->blocks[victim][k]) ;
+		}
+		auto end = std::chrono::steady_clock::now() ;
+		cross->barrier.arrive_and_wait() ;
+		alloc_time += std::chrono::duration<double>(middle - start).count() ;
+		free_time += std::chrono::duration<double>(end - resume).count() ;
+	}
+	state.SetItemsProcessed(state.iterations() * churn_batch);
+	const double blocks = static_cast<double>(state.iterations()) * churn_batch ;
+	state.counters["alloc_ns"] = benchmark::Counter(1e9 * alloc_time / blocks, benchmark::Counter::kAvgThreads) ;
+	state.counters["free_ns"] = benchmark::Counter(1e9 * free_time / blocks, benchmark::Counter::kAvgThreads) ;
+	leave_churn(shared, cross) ;
+}
+
+// Long-running churn of AMR adaptation cycles : per-level arrays (level l : about 4 KB << l,
+// +/- 50 %) are allocated and filled, then at each cycle a quarter of them is freed (coarsening)
+// and about as many are allocated with new sizes (refinement). range(0) = number of cycles.
+// Backends, with the size given back at deallocation :
+struct amr_block {
+	void* data ;
+	std::size_t bytes ;
+};
+
+struct amr_malloc {
+	void* allocate(std::size_t bytes) { return std::malloc(bytes) ; }
+	void deallocate(void* p, std::size_t) { std::free(p) ; }
+	void end_cycle(std::vector<amr_block>&) {}
+};
+
+struct amr_aligned {
+	void* allocate(std::size_t bytes) { return std::aligned_alloc(64, (bytes + 63) / 64 * 64) ; }
+	void deallocate(void* p, std::size_t) { std::free(p) ; }
+	void end_cycle(std::vector<amr_block>&) {}
+};
+
+// std::pmr pool : blocks sorted by size in chunks kept by the resource, large blocks from upstream
+struct amr_pmr_pool {
+	std::pmr::unsynchronized_pool_resource pool ;
+	void* allocate(std::size_t bytes) { return pool.allocate(bytes, 64) ; }
+	void deallocate(void* p, std::size_t bytes) { pool.deallocate(p, bytes, 64) ; }
+	void end_cycle(std::vector<amr_block>&) {}
+};
+
+// Arena approach : the mesh is rebuilt at each cycle, so the live arrays are copied into a
+// second arena, and the old one is reset (no individual free, two arenas at the peak).
+struct amr_arena {
+	arena arenas[2] {arena(1 << 20), arena(1 << 20)} ;
+	int current = 0 ;
+	void* allocate(std::size_t bytes) { return arenas[current].allocate(bytes) ; }
+	void deallocate(void*, std::size_t) {}
+	void end_cycle(std::vector<amr_block>& blocks) {
+		arena& next = arenas[1 - current] ;
+		for (amr_block& block : blocks) {
+			void* data = next.allocate(block.bytes) ;
+			std::memcpy(data, block.data, block.bytes) ;
+			block.data = data ;
+		}
+		arenas[current].reset() ;
+		current = 1 - current ;
+	}
+};
+
+const int amr_levels = 6 ;
+const int amr_arrays_per_level = 32 ;
+
+// Counters (last iteration), RSS measured from the start of the simulation :
+// - peak_rss / final_rss : RSS at the peak (sampled after the initial population and after
+//   each cycle) and after the last cycle. Differences are signed : negative when the RSS fell
+//   below the baseline
+// - retained : RSS still held once every array is freed (memory not given back)
+// - overhead : peak_rss / peak of the bytes really requested (1 = no waste)
+// - live_bytes : bytes requested at the peak
+template <typename Backend>
+void ALLOC_amr_cycles(benchmark::State& state) {
+	const int cycles = state.range(0) ;
+	// signed : the RSS can go below the baseline (large blocks given back with munmap)
+	int64_t peak_rss = 0 ;
+	int64_t final_rss = 0 ;
+	int64_t retained = 0 ;
+	std::size_t peak_live = 0 ;
+	for (auto _ : state) {
+		state.PauseTiming() ;
+		malloc_trim(0) ;  // same starting point for every backend
+		const int64_t baseline = static_cast<int64_t>(resident_bytes()) ;
+		auto rss = [baseline] { return static_cast<int64_t>(resident_bytes()) - baseline ; } ;
+		peak_rss = 0 ;
+		peak_live = 0 ;
+		std::mt19937 gen(1234) ;
+		std::uniform_real_distribution<double> factor(0.5, 1.5) ;
+		std::uniform_int_distribution<int> level_of(0, amr_levels - 1) ;
+		std::uniform_int_distribution<int> drift(-4, 4) ;
+		std::bernoulli_distribution coarsen(0.25) ;
+		auto array_bytes = [&](int level) { return static_cast<std::size_t>((4096 << level) * factor(gen)) ; } ;
+		state.ResumeTiming() ;
+
+		{
+			Backend backend ;
+			std::vector<amr_block> blocks ;
+			std::size_t live = 0 ;
+			auto add = [&](std::size_t bytes) {
+				void* data = backend.allocate(bytes) ;
+				std::memset(data, 1, bytes) ;
+				blocks.push_back({data, bytes}) ;
+				live += bytes ;
+			} ;
+			for (int level = 0 ; level < amr_levels ; level++) {
+				for (int k = 0 ; k < amr_arrays_per_level ; k++) {
+					add(array_bytes(level)) ;
+				}
+			}
+			state.PauseTiming() ;
+			peak_rss = std::max<int64_t>(0, rss()) ;
+			peak_live = live ;
+			state.ResumeTiming() ;
+			for (int cycle = 0 ; cycle < cycles ; cycle++) {
+				// coarsening : a quarter of the arrays is freed
+				std::size_t kept = 0 ;
+				int freed = 0 ;
+				for (std::size_t k = 0 ; k < blocks.size() ; k++) {
+					if (coarsen(gen)) {
+						backend.deallocate(blocks[k].data, blocks[k].bytes) ;
+						live -= blocks[k].bytes ;
+						freed++ ;
+					} else {
+						blocks[kept++] = blocks[k] ;
+					}
+				}
+				blocks.resize(kept) ;
+				// refinement : about as many new arrays, on random levels
+				const int created = std::max(0, freed + drift(gen)) ;
+				for (int k = 0 ; k < created ; k++) {
+					add(array_bytes(level_of(gen))) ;
+				}
+				backend.end_cycle(blocks) ;
+
+				state.PauseTiming() ;
+				peak_rss = std::max(peak_rss, rss()) ;
+				peak_live = std::max(peak_live, live) ;
+				state.ResumeTiming() ;
+			}
+			state.PauseTiming() ;
+			final_rss = rss() ;
+			state.ResumeTiming() ;
+			for (amr_block& block : blocks) {
+				backend.deallocate(block.data, block.bytes) ;
+			}
+			state.PauseTiming() ;
+			retained = rss() ;
+			state.ResumeTiming() ;
+		}
+	}
+	state.counters["peak_rss"] = benchmark::Counter(static_cast<double>(peak_rss), benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024) ;
+	state.counters["final_rss"] = benchmark::Counter(static_cast<double>(final_rss), benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024) ;
+	state.counters["retained"] = benchmark::Counter(static_cast<double>(retained), benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024) ;
+	state.counters["live_bytes"] = benchmark::Counter(peak_live, benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024) ;
+	state.counters["overhead"] = peak_live > 0 ? static_cast<double>(peak_rss) / peak_live : 0.0 ;
+}
+
 #ifdef XBENCHMARK_USE_XTENSOR
 template <typename T, typename Op>
 void ALLOC_xarray(benchmark::State& state) {
@@ -119,6 +654,31 @@ void ALLOC_xtensor_aligned(benchmark::State& state) {
 #endif
 
 
+#ifdef XBENCHMARK_USE_KOKKOS
+// Kokkos::View<T*, Space> allocated in the timed loop, then filled with deep_copy as
+// ALLOC_xtensor. Initialize = true : the constructor with a label zero-initialises the View
+// with a parallel_for on Space (two passes over the memory, as std::vector), false :
+// view_alloc(WithoutInitializing) leaves it uninitialised (one pass, as uninitialized_vector).
+// The label is copied into the allocation record at each construction.
+template <typename T, typename Space, bool Initialize>
+void ALLOC_kokkos(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	for (auto _ : state) {
+		Kokkos::View<T*, Space> vec ;
+		if constexpr (Initialize) {
+			vec = Kokkos::View<T*, Space>("vec", vector_size) ;
+		} else {
+			vec = Kokkos::View<T*, Space>(Kokkos::view_alloc(Kokkos::WithoutInitializing, "vec"), vector_size) ;
+		}
+		Kokkos::deep_copy(vec, T(1)) ;
+		benchmark::DoNotOptimize(vec.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(kokkos_label<Space>());
+}
+#endif
+
+
 #ifdef XBENCHMARK_USE_XTENSOR
 template <std::size_t S>
 void ALLOC_xtensor_fixed(benchmark::State& state) {
@@ -135,12 +695,51 @@ void ALLOC_xtensor_fixed(benchmark::State& state) {
 // Power of two rule
 BENCHMARK_TEMPLATE(ALLOC_raw, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(ALLOC_aligned, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(ALLOC_arena, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+// large arrays only : from 256 KB to 256 MB
+BENCHMARK_TEMPLATE(ALLOC_pages, float, page_mode::small)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(ALLOC_pages, float, page_mode::huge)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(ALLOC_pages, float, page_mode::hugetlb)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(ALLOC_mmap, float)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(ALLOC_mmap_populate, float)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(ALLOC_dontneed, float)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(ALLOC_reused, float)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
 BENCHMARK_TEMPLATE(ALLOC_std_vector, float,		std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(ALLOC_vector_fill, float, std::vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(ALLOC_vector_fill, float, uninitialized_vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(ALLOC_arena_std_vector, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+// small sizes only : beyond N, this is a std::vector
+BENCHMARK_TEMPLATE(ALLOC_small_vector, float, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, 64, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(ALLOC_small_vector, float, 8)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, 64, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(ALLOC_small_vector, float, 16)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, 64, threshold1, threshold2);});;
+// multi-threaded : blocks up to 64 B, 1 KB and 16 KB
+BENCHMARK_TEMPLATE(ALLOC_churn, malloc_backend)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_churn, pool_backend)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_churn, arena_backend)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_free_pattern, malloc_backend, false)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_free_pattern, malloc_backend, true)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_free_pattern, pool_backend, false)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_free_pattern, pool_backend, true)->ArgName("max_bytes")->Arg(64)->Arg(1024)->Arg(16384)->ThreadRange(1, ncores)->UseRealTime();
+// AMR adaptation cycles : 10 to 1000 cycles per iteration
+BENCHMARK_TEMPLATE(ALLOC_amr_cycles, amr_malloc)->ArgName("cycles")->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(ALLOC_amr_cycles, amr_aligned)->ArgName("cycles")->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(ALLOC_amr_cycles, amr_pmr_pool)->ArgName("cycles")->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(ALLOC_amr_cycles, amr_arena)->ArgName("cycles")->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
 #ifdef XBENCHMARK_USE_XTENSOR
 BENCHMARK_TEMPLATE(ALLOC_xarray, float, 	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(ALLOC_xtensor, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(ALLOC_xtensor_aligned, float,        std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #endif
+#ifdef XBENCHMARK_USE_KOKKOS
+#ifdef KOKKOS_ENABLE_SERIAL
+BENCHMARK_TEMPLATE(ALLOC_kokkos, float, Kokkos::Serial, true)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_kokkos, float, Kokkos::Serial, false)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+BENCHMARK_TEMPLATE(ALLOC_kokkos, float, Kokkos::OpenMP, true)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(ALLOC_kokkos, float, Kokkos::OpenMP, false)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#endif
 
 
 
@@ -173,7 +772,11 @@ BENCHMARK_TEMPLATE(ALLOC_xtensor_fixed, 524288);
 #endif
 
 
+#ifdef XBENCHMARK_USE_KOKKOS
+XBENCHMARK_KOKKOS_MAIN();
+#else
 BENCHMARK_MAIN();
+#endif
 
 
 
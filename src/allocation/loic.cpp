@@ -1,69 +1,203 @@
-#include <array>
 #include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#ifdef XBENCHMARK_USE_XTENSOR
 #include <xtensor/xfixed.hpp>
 #include <xtensor/xnoalias.hpp>
+#endif
+
+#ifdef XBENCHMARK_USE_EIGEN
+#include <Eigen/Dense>
+#endif
 
-inline auto& f_array(std::array<double, 4>& a)
-{
-    std::array<double, 4> b;
+#include <utils/small_vector.hpp>
+#include <utils/size_dispatch.hpp>
+#include <utils/allocation_counter.hpp>
 
-    for (std::size_t i = 0; i < 4; ++i)
-    {
-        a[i] = 4 * b[i] + 1;
-    }
-    return a;
+// Tiny per-cell temporaries (stencil coefficients, fluxes, ...) of N = 1 to 64 doubles.
+// Every benchmark creates the temporary inside the timed loop and evaluates the same fused
+// expression tmp = 4 * x + y + 1 on persistent inputs x and y of the same container type.
+// range(0) = N, turned into a template parameter by dispatch_size once per benchmark, so that
+// the fixed-size containers get their size at compile time.
+// Counters : items_per_second (elements of tmp) ; with XBENCHMARK_COUNT_ALLOCATIONS, allocs and
+// alloc_bytes = heap allocations of the timed loop per iteration (report_heap_allocations).
+const std::size_t max_tiny_size = 64 ;
+
+template <typename Container>
+void fill_inputs(Container& x, Container& y) {
+	for (std::size_t i = 0 ; i < x.size() ; i++) {
+		x[i] = static_cast<double>(i) ;
+		y[i] = 2.0 * i ;
+	}
 }
 
-inline auto& f_xfixed_unroll(xt::xtensor_fixed<double, xt::xshape<4>>& a)
-{
-    xt::xtensor_fixed<double, xt::xshape<4>> b;
+template <typename Body>
+void run_tiny(benchmark::State& state, Body&& body) {
+	if (!dispatch_size<max_tiny_size>(state.range(0), body)) {
+		state.SkipWithError("size out of range") ;
+		return ;
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0)) ;
+}
 
-    for (std::size_t i = 0; i < 4; ++i)
-    {
-        a[i] = 4 * b[i] + 1;
-    }
-    return a;
+// std::array<double, N> : stack storage, size in the type
+void TINY_std_array(benchmark::State& state) {
+	run_tiny(state, [&](auto size) {
+		constexpr std::size_t N = decltype(size)::value ;
+		std::array<double, N> x ;
+		std::array<double, N> y ;
+		fill_inputs(x, y) ;
+		heap_counter allocations ;
+		allocations.start() ;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.data()) ;
+			benchmark::DoNotOptimize(y.data()) ;
+			std::array<double, N> tmp ;
+			for (std::size_t i = 0 ; i < N ; i++) {
+				tmp[i] = 4 * x[i] + y[i] + 1 ;
+			}
+			benchmark::DoNotOptimize(tmp.data()) ;
+			benchmark::ClobberMemory() ;
+		}
+		allocations.stop() ;
+		report_heap_allocations(state, allocations) ;
+	}) ;
 }
 
-inline auto& f_xfixed_lazy(xt::xtensor_fixed<double, xt::xshape<4>>& a)
-{
-    xt::xtensor_fixed<double, xt::xshape<4>> b;
-    xt::noalias(a) = 4 * b + 1;
-    return a;
+// small_vector<double, 64> : fixed inline capacity, size known at run time only (never on
+// the heap for N <= 64)
+void TINY_inline_vector(benchmark::State& state) {
+	run_tiny(state, [&](auto size) {
+		constexpr std::size_t N = decltype(size)::value ;
+		small_vector<double, max_tiny_size> x(N, 0.0) ;
+		small_vector<double, max_tiny_size> y(N, 0.0) ;
+		fill_inputs(x, y) ;
+		const std::size_t n = state.range(0) ;
+		heap_counter allocations ;
+		allocations.start() ;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.data()) ;
+			benchmark::DoNotOptimize(y.data()) ;
+			small_vector<double, max_tiny_size> tmp(n, 0.0) ;
+			for (std::size_t i = 0 ; i < n ; i++) {
+				tmp[i] = 4 * x[i] + y[i] + 1 ;
+			}
+			benchmark::DoNotOptimize(tmp.data()) ;
+			benchmark::ClobberMemory() ;
+		}
+		allocations.stop() ;
+		report_heap_allocations(state, allocations) ;
+	}) ;
 }
 
-static void BM_std_array(benchmark::State& state)
-{
-    std::array<double, 4> a;
+// std::vector<double> : one heap allocation (and zero-fill) per temporary
+void TINY_std_vector(benchmark::State& state) {
+	run_tiny(state, [&](auto size) {
+		constexpr std::size_t N = decltype(size)::value ;
+		std::vector<double> x(N) ;
+		std::vector<double> y(N) ;
+		fill_inputs(x, y) ;
+		heap_counter allocations ;
+		allocations.start() ;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.data()) ;
+			benchmark::DoNotOptimize(y.data()) ;
+			std::vector<double> tmp(N) ;
+			for (std::size_t i = 0 ; i < N ; i++) {
+				tmp[i] = 4 * x[i] + y[i] + 1 ;
+			}
+			benchmark::DoNotOptimize(tmp.data()) ;
+			benchmark::ClobberMemory() ;
+		}
+		allocations.stop() ;
+		report_heap_allocations(state, allocations) ;
+	}) ;
+}
 
-    for (auto _ : state)
-    {
-        benchmark::DoNotOptimize(f_array(a));
-        benchmark::ClobberMemory();
-    }
+#ifdef XBENCHMARK_USE_XTENSOR
+// xt::xtensor_fixed<double, xt::xshape<N>>, element loop
+void TINY_xtensor_fixed_loop(benchmark::State& state) {
+	run_tiny(state, [&](auto size) {
+		constexpr std::size_t N = decltype(size)::value ;
+		xt::xtensor_fixed<double, xt::xshape<N>> x ;
+		xt::xtensor_fixed<double, xt::xshape<N>> y ;
+		fill_inputs(x, y) ;
+		heap_counter allocations ;
+		allocations.start() ;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.data()) ;
+			benchmark::DoNotOptimize(y.data()) ;
+			xt::xtensor_fixed<double, xt::xshape<N>> tmp ;
+			for (std::size_t i = 0 ; i < N ; i++) {
+				tmp[i] = 4 * x[i] + y[i] + 1 ;
+			}
+			benchmark::DoNotOptimize(tmp.data()) ;
+			benchmark::ClobberMemory() ;
+		}
+		allocations.stop() ;
+		report_heap_allocations(state, allocations) ;
+	}) ;
 }
 
-static void BM_xt_xfixed_unroll(benchmark::State& state)
-{
-    xt::xtensor_fixed<double, xt::xshape<4>> a;
-    for (auto _ : state)
-    {
-        benchmark::DoNotOptimize(f_xfixed_unroll(a));
-        benchmark::ClobberMemory();
-    }
+// xt::xtensor_fixed<double, xt::xshape<N>>, lazy expression assigned with noalias
+void TINY_xtensor_fixed_lazy(benchmark::State& state) {
+	run_tiny(state, [&](auto size) {
+		constexpr std::size_t N = decltype(size)::value ;
+		xt::xtensor_fixed<double, xt::xshape<N>> x ;
+		xt::xtensor_fixed<double, xt::xshape<N>> y ;
+		fill_inputs(x, y) ;
+		heap_counter allocations ;
+		allocations.start() ;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.data()) ;
+			benchmark::DoNotOptimize(y.data()) ;
+			xt::xtensor_fixed<double, xt::xshape<N>> tmp ;
+			xt::noalias(tmp) = 4 * x + y + 1 ;
+			benchmark::DoNotOptimize(tmp.data()) ;
+			benchmark::ClobberMemory() ;
+		}
+		allocations.stop() ;
+		report_heap_allocations(state, allocations) ;
+	}) ;
 }
+#endif
 
-static void BM_xt_xfixed_lazy(benchmark::State& state)
-{
-    xt::xtensor_fixed<double, xt::xshape<4>> a;
-    for (auto _ : state)
-    {
-        benchmark::DoNotOptimize(f_xfixed_lazy(a));
-        benchmark::ClobberMemory();
-    }
+#ifdef XBENCHMARK_USE_EIGEN
+// Eigen::Matrix<double, N, 1> : fixed-size, stack storage, expression templates
+void TINY_eigen_fixed(benchmark::State& state) {
+	run_tiny(state, [&](auto size) {
+		constexpr int N = static_cast<int>(decltype(size)::value) ;
+		Eigen::Matrix<double, N, 1> x ;
+		Eigen::Matrix<double, N, 1> y ;
+		for (int i = 0 ; i < N ; i++) {
+			x[i] = static_cast<double>(i) ;
+			y[i] = 2.0 * i ;
+		}
+		heap_counter allocations ;
+		allocations.start() ;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.data()) ;
+			benchmark::DoNotOptimize(y.data()) ;
+			Eigen::Matrix<double, N, 1> tmp = (4 * x.array() + y.array() + 1).matrix() ;
+			benchmark::DoNotOptimize(tmp.data()) ;
+			benchmark::ClobberMemory() ;
+		}
+		allocations.stop() ;
+		report_heap_allocations(state, allocations) ;
+	}) ;
 }
+#endif
 
-BENCHMARK(BM_std_array);
-BENCHMARK(BM_xt_xfixed_unroll);
-BENCHMARK(BM_xt_xfixed_lazy);
+BENCHMARK(TINY_std_array)->ArgName("size")->DenseRange(1, max_tiny_size);
+BENCHMARK(TINY_inline_vector)->ArgName("size")->DenseRange(1, max_tiny_size);
+BENCHMARK(TINY_std_vector)->ArgName("size")->DenseRange(1, max_tiny_size);
+#ifdef XBENCHMARK_USE_XTENSOR
+BENCHMARK(TINY_xtensor_fixed_loop)->ArgName("size")->DenseRange(1, max_tiny_size);
+BENCHMARK(TINY_xtensor_fixed_lazy)->ArgName("size")->DenseRange(1, max_tiny_size);
+#endif
+#ifdef XBENCHMARK_USE_EIGEN
+BENCHMARK(TINY_eigen_fixed)->ArgName("size")->DenseRange(1, max_tiny_size);
+#endif
 BENCHMARK_MAIN();
@@ -21,6 +21,22 @@
 
 
 #include <utils/custom_arguments.hpp>
+#ifdef XBENCHMARK_USE_OPENMP
+#include <utils/omp_benchmark.hpp>
+#endif
+#include <blas1/isa_kernels.hpp>
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+#include <blas1/xsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#include <blas1/simd_kernels.hpp>
+#endif
+#include <allocation/default_init_allocator.hpp>
+#include <allocation/caching_allocator.hpp>
+#include <utils/allocation_counter.hpp>
 
 int min = 1 ;
 int max = 1000000 ;
@@ -92,6 +108,176 @@ void BLAS1_op_aligned(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// Plain loop compiled once per ISA level (include/blas1/isa_kernels.hpp), skipped when the
+// CPU, XBENCHMARK_ISA or the build baseline does not allow level L
+template <typename T, typename Op, isa_level L>
+void BLAS1_op_isa(benchmark::State& state) {
+	if (const char* reason = isa_unavailable(L)) {
+		state.SkipWithError(reason);
+		return;
+	}
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+	}
+	for (auto _ : state) {
+		isa_kernels<L>::map(result, vector_size, [](const T& x) { return Op()(x, static_cast<T>(1.0)) ; }, vec1) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// Same loop, version chosen at run time (best level of the CPU, capped by XBENCHMARK_ISA)
+template <typename T, typename Op>
+void BLAS1_op_dispatch(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+	}
+	auto add_one = [](const T& x) { return Op()(x, static_cast<T>(1.0)) ; } ;
+	using F = decltype(add_one) ;
+	// resolved once, as an ifunc resolver would do
+	void (*op)(T*, std::size_t, F, const T*) = dispatch_isa(active_isa(), [](auto level) {
+		return &isa_kernels<decltype(level)::value>::template map<T, F, T> ;
+	}) ;
+	for (auto _ : state) {
+		op(result, vector_size, add_one, vec1) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(isa_name(active_isa()));
+}
+
+#ifdef XBENCHMARK_USE_STDSIMD
+// Portable SIMD with std::experimental::simd (include/blas1/stdsimd_kernels.hpp)
+template <typename T, typename Op>
+void BLAS1_op_stdsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+	}
+	const native_simd<T> scalar(static_cast<T>(1.0)) ;
+	for (auto _ : state) {
+		stdsimd_map(result, vector_size, [scalar](const native_simd<T>& x) { return stdsimd_op<Op>()(x, scalar) ; }, vec1) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XSIMD
+// xsimd::batch written by hand (include/blas1/xsimd_kernels.hpp), the scalar broadcast once
+template <typename T, typename Op>
+void BLAS1_op_xsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+	}
+	// called on xsimd::batch<T> for the full batches and on T for the tail
+	auto kernel = [](const auto& x) {
+		using V = std::decay_t<decltype(x)> ;
+		return xsimd_op<Op>()(x, V(static_cast<T>(1.0))) ;
+	} ;
+	for (auto _ : state) {
+		xsimd_map(result, vector_size, kernel, vec1) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// Hand-written AVX2 / AVX-512 kernel (include/blas1/simd_kernels.hpp), float only : upper bound
+// for BLAS1_op_aligned. Aligned = false : unaligned loads / stores on arrays shifted by 4 bytes.
+template <typename ISA, typename Op, bool Aligned, std::size_t Unroll>
+void BLAS1_op_intrinsics(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	simd_buffer<float> vec1(vector_size, Aligned, 1) ;
+	simd_buffer<float> result(vector_size, Aligned, 0) ;
+	const typename ISA::reg scalar = ISA::set1(1.0f) ;
+	for (auto _ : state) {
+		simd_map<ISA, Aligned, Unroll>(result.data(), vector_size, [scalar](typename ISA::reg x) { return simd_op<ISA, Op>::apply(x, scalar) ; }, vec1.data()) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+
+#ifdef XBENCHMARK_USE_OPENMP
+// BLAS1_op_raw (Aligned = false, malloc) / BLAS1_op_aligned (Aligned = true) split over OpenMP
+// threads (include/utils/omp_benchmark.hpp) : range(1) = threads, range(2) = chunk, Schedule =
+// omp_sched_static / dynamic / guided. Arrays first touched by the threads that compute them.
+template <typename T, typename Op, omp_sched_t Schedule, bool Aligned>
+void BLAS1_op_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ; 
+	omp_run run(state, Schedule) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* result = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	run.parallel_for(vector_size, [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			vec1[i] = 1;
+			result[i] = 0;
+		}
+	}) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			result[i] = operation(vec1[i], static_cast<T>(1.0)) ;
+		}
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(result);
+	run.report(state, vector_size, 2 * sizeof(T)) ;
+}
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// BLAS1_op_intrinsics (aligned, Unroll = 4) on each block : blocks start on a 64-element boundary
+template <typename ISA, typename Op, omp_sched_t Schedule>
+void BLAS1_op_intrinsics_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	omp_run run(state, Schedule) ;
+	simd_buffer<float> vec1(vector_size, true, 1) ;
+	simd_buffer<float> result(vector_size, true, 0) ;
+	const typename ISA::reg scalar = ISA::set1(1.0f) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		simd_map<ISA, true, 4>(result.data() + first, last - first, [scalar](typename ISA::reg x) { return simd_op<ISA, Op>::apply(x, scalar) ; }, vec1.data() + first) ;
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	run.report(state, vector_size, 2 * sizeof(float)) ;
+}
+#endif
+#endif
 
 template <typename T, typename Op>
 void BLAS1_op_std_vector(benchmark::State& state) {
@@ -108,6 +294,22 @@ void BLAS1_op_std_vector(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// allocate + produce result : std::vector<T>(n) (zero-fill + kernel) or uninitialized_vector<T>(n) (kernel only)
+template <typename T, typename Op, typename Vector>
+void BLAS1_op_alloc(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation;
+	std::vector<T> vec1(vector_size, 1);
+	for (auto _ : state) {
+		Vector result(vector_size);
+		for (int i = 0; i < vector_size; ++i) {
+			result[i] = operation(vec1[i] , static_cast<T>(1.0)) ;
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
 #ifdef XBENCHMARK_USE_XTENSOR
 template <typename T, typename Op>
 void BLAS1_op_xarray(benchmark::State& state) {
@@ -115,6 +317,8 @@ void BLAS1_op_xarray(benchmark::State& state) {
 	xt::xarray<T> vec1 = xt::xarray<T>::from_shape({vector_size});
 	xt::xarray<T> result = xt::xarray<T>::from_shape({vector_size});
 	vec1.fill(1.0) ; 
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		// lot of constexpr because of xtensor itself
 		if constexpr(std::is_same_v<Op, std::plus<T>>){
@@ -128,7 +332,9 @@ void BLAS1_op_xarray(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -316,6 +522,8 @@ void BLAS1_op_xtensor_eval(benchmark::State& state) {
 	xt::xtensor<T, 1> result = xt::xtensor<T,1>::from_shape({vector_size});
 	vec1.fill(1);
 	result.fill(0);
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		// lots of constexpr becaus of xtensor itself
 		if constexpr(std::is_same_v<Op, std::plus<T>>){
@@ -329,7 +537,73 @@ void BLAS1_op_xtensor_eval(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// Same as BLAS1_op_xarray, the temporary of xt::eval comes from the caching pool (caching_allocator.hpp).
+// Counter pool_misses : allocations that reached the system, per iteration.
+template <typename T, typename Op>
+void BLAS1_op_xarray_caching(benchmark::State& state) {
+	const unsigned long vector_size = static_cast<unsigned long>(state.range(0));
+	xt::xarray<T> vec1 = xt::xarray<T>::from_shape({vector_size});
+	xt::xarray<T> result = xt::xarray<T>::from_shape({vector_size});
+	vec1.fill(1.0) ;
+	caching_pool& pool = caching_pool::local() ;
+	const std::size_t misses = pool.misses() ;
+	heap_counter allocations ;
+	allocations.start() ;
+	for (auto _ : state) {
+		if constexpr(std::is_same_v<Op, std::plus<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 + static_cast<T>(1.0));
+		} else if constexpr(std::is_same_v<Op, std::minus<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 - static_cast<T>(1.0));
+		} else if constexpr(std::is_same_v<Op, std::multiplies<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 * static_cast<T>(1.0));
+		} else if constexpr(std::is_same_v<Op, std::divides<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 / static_cast<T>(1.0));
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	allocations.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["pool_misses"] = static_cast<double>(pool.misses() - misses) / state.iterations() ;
+	report_heap_allocations(state, allocations) ;
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// Same as BLAS1_op_xtensor_eval, the temporary comes from the caching pool.
+template <typename T, typename Op>
+void BLAS1_op_xtensor_eval_caching(benchmark::State& state) {
+	const unsigned long vector_size = state.range(0);
+	xt::xtensor<T, 1> vec1   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> result = xt::xtensor<T,1>::from_shape({vector_size});
+	vec1.fill(1);
+	result.fill(0);
+	caching_pool& pool = caching_pool::local() ;
+	const std::size_t misses = pool.misses() ;
+	heap_counter allocations ;
+	allocations.start() ;
+	for (auto _ : state) {
+		if constexpr(std::is_same_v<Op, std::plus<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 + static_cast<T>(1.0));
+		} else if constexpr(std::is_same_v<Op, std::minus<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 - static_cast<T>(1.0));
+		} else if constexpr(std::is_same_v<Op, std::multiplies<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 * static_cast<T>(1.0));
+		} else if constexpr(std::is_same_v<Op, std::divides<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 / static_cast<T>(1.0));
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["pool_misses"] = static_cast<double>(pool.misses() - misses) / state.iterations() ;
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -387,8 +661,34 @@ BENCHMARK_TEMPLATE(BLAS1_op_eigen_matrix, float, std::plus<      float>)->Apply(
 
 // Power of two rule
 BENCHMARK_TEMPLATE(BLAS1_op_raw, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK_TEMPLATE(BLAS1_op_stdsimd, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+BENCHMARK_TEMPLATE(BLAS1_op_xsimd, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_TEMPLATE(BLAS1_op_aligned, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_isa, float,	std::plus<	float>, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_isa, float,	std::plus<	float>, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_isa, float,	std::plus<	float>, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_dispatch, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#ifdef XBENCHMARK_HAS_AVX2
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_HAS_AVX512
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#endif
 BENCHMARK_TEMPLATE(BLAS1_op_std_vector, float,		std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_alloc, float, std::plus<float>, std::vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_alloc, float, std::plus<float>, uninitialized_vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 
 #ifdef XBENCHMARK_USE_XTENSOR
 BENCHMARK_TEMPLATE(BLAS1_op_xarray, float, 	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
@@ -400,6 +700,8 @@ BENCHMARK_TEMPLATE(BLAS1_op_xtensor_explicit_aligned_16, float,     std::plus<
 BENCHMARK_TEMPLATE(BLAS1_op_xtensor_explicit_aligned_64, float,     std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #endif
 BENCHMARK_TEMPLATE(BLAS1_op_xtensor_eval, float,        std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_xarray_caching, float,      std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_xtensor_eval_caching, float, std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #endif
 
 
@@ -464,6 +766,27 @@ BENCHMARK_TEMPLATE(BLAS1_op_xtensor_fixed_explicit, 16384);
 #endif
 
 
+#ifdef XBENCHMARK_USE_OPENMP
+// chunk 0 (one block per thread) for static only
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_static, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_dynamic, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_guided, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_static, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_dynamic, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_guided, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#if defined(XBENCHMARK_HAS_AVX512)
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx512_isa, std::plus<float>, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx512_isa, std::plus<float>, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx512_isa, std::plus<float>, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#elif defined(XBENCHMARK_HAS_AVX2)
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx2_isa, std::plus<float>, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx2_isa, std::plus<float>, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx2_isa, std::plus<float>, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#endif
+#endif
+#endif
+
 BENCHMARK_MAIN();
 
 
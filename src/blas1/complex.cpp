@@ -15,6 +15,22 @@
 
 
 #include <utils/custom_arguments.hpp>
+#ifdef XBENCHMARK_USE_OPENMP
+#include <utils/omp_benchmark.hpp>
+#endif
+#include <blas1/isa_kernels.hpp>
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+#include <blas1/xsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#include <blas1/simd_kernels.hpp>
+#endif
+#include <allocation/default_init_allocator.hpp>
+#include <allocation/caching_allocator.hpp>
+#include <utils/allocation_counter.hpp>
 
 int min = 1 ;
 int max = 1000000 ;
@@ -115,6 +131,245 @@ void BLAS1_complex_aligned(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// Plain loop compiled once per ISA level (include/blas1/isa_kernels.hpp), skipped when the
+// CPU, XBENCHMARK_ISA or the build baseline does not allow level L : the avx2 / avx512 versions
+// contract the products into vfmadd, the sse42 one has no fma instruction
+template <typename T, typename Op, isa_level L>
+void BLAS1_complex_isa(benchmark::State& state) {
+	if (const char* reason = isa_unavailable(L)) {
+		state.SkipWithError(reason);
+		return;
+	}
+	const int vector_size = state.range(0);
+	const T a = static_cast<T>(2.0) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec3 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec4 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		vec3[i] = 3;
+		vec4[i] = 4;
+		result[i] = 0 ;
+	}
+	for (auto _ : state) {
+		isa_kernels<L>::map(result, vector_size, [a](const T& x, const T& y, const T& z, const T& w) { return Op()(a, x, y, z, w) ; }, vec1, vec2, vec3, vec4) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(vec3);
+	std::free(vec4);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// Same loop, version chosen at run time (best level of the CPU, capped by XBENCHMARK_ISA)
+template <typename T, typename Op>
+void BLAS1_complex_dispatch(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	const T a = static_cast<T>(2.0) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec3 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec4 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		vec3[i] = 3;
+		vec4[i] = 4;
+		result[i] = 0 ;
+	}
+	auto complex = [a](const T& x, const T& y, const T& z, const T& w) { return Op()(a, x, y, z, w) ; } ;
+	using F = decltype(complex) ;
+	// resolved once, as an ifunc resolver would do
+	void (*op)(T*, std::size_t, F, const T*, const T*, const T*, const T*) = dispatch_isa(active_isa(), [](auto level) {
+		return &isa_kernels<decltype(level)::value>::template map<T, F, T, T, T, T> ;
+	}) ;
+	for (auto _ : state) {
+		op(result, vector_size, complex, vec1, vec2, vec3, vec4) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(vec3);
+	std::free(vec4);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(isa_name(active_isa()));
+}
+
+#ifdef XBENCHMARK_USE_STDSIMD
+// Portable SIMD with std::experimental::simd (include/blas1/stdsimd_kernels.hpp) : complex_op on registers
+template <typename T, typename Op>
+void BLAS1_complex_stdsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	const native_simd<T> a(static_cast<T>(2.0)) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec3 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec4 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		vec3[i] = 3; 
+		vec4[i] = 4; 
+		result[i] = 0 ;
+	}
+	// complex_op::operator() is written on const T&, the same formula on registers
+	auto kernel = [a](const native_simd<T>& v1, const native_simd<T>& v2, const native_simd<T>& v3, const native_simd<T>& v4) {
+		return a * v1 + v2 * v3 * v4 ;
+	} ;
+	for (auto _ : state) {
+		stdsimd_map(result, vector_size, kernel, vec1, vec2, vec3, vec4) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(vec3) ; 
+	std::free(vec4) ;
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XSIMD
+// xsimd::batch written by hand (include/blas1/xsimd_kernels.hpp) : complex_op on batches
+template <typename T, typename Op>
+void BLAS1_complex_xsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec3 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec4 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		vec3[i] = 3; 
+		vec4[i] = 4; 
+		result[i] = 0 ;
+	}
+	// same formula as complex_op, on xsimd::batch<T> and on T for the tail
+	auto kernel = [](const auto& v1, const auto& v2, const auto& v3, const auto& v4) {
+		using V = std::decay_t<decltype(v1)> ;
+		return V(static_cast<T>(2.0)) * v1 + v2 * v3 * v4 ;
+	} ;
+	for (auto _ : state) {
+		xsimd_map(result, vector_size, kernel, vec1, vec2, vec3, vec4) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(vec3) ; 
+	std::free(vec4) ;
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// Hand-written AVX2 / AVX-512 kernel of complex_op, a * vec1 + vec2 * vec3 * vec4 : two mul and
+// one fmadd per register (include/blas1/simd_kernels.hpp). Aligned = false : arrays shifted by 4 bytes.
+template <typename ISA, bool Aligned, std::size_t Unroll>
+void BLAS1_complex_intrinsics(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	simd_buffer<float> vec1(vector_size, Aligned, 1) ;
+	simd_buffer<float> vec2(vector_size, Aligned, 2) ;
+	simd_buffer<float> vec3(vector_size, Aligned, 3) ;
+	simd_buffer<float> vec4(vector_size, Aligned, 4) ;
+	simd_buffer<float> result(vector_size, Aligned, 0) ;
+	const typename ISA::reg a = ISA::set1(2.0f) ;
+	auto kernel = [a](typename ISA::reg v1, typename ISA::reg v2, typename ISA::reg v3, typename ISA::reg v4) {
+		return ISA::fmadd(a, v1, ISA::mul(ISA::mul(v2, v3), v4)) ;
+	} ;
+	for (auto _ : state) {
+		simd_map<ISA, Aligned, Unroll>(result.data(), vector_size, kernel, vec1.data(), vec2.data(), vec3.data(), vec4.data()) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+
+#ifdef XBENCHMARK_USE_OPENMP
+// BLAS1_complex_raw (Aligned = false, malloc) / BLAS1_complex_aligned (Aligned = true) split over OpenMP
+// threads (include/utils/omp_benchmark.hpp) : range(1) = threads, range(2) = chunk, Schedule =
+// omp_sched_static / dynamic / guided. Arrays first touched by the threads that compute them.
+template <typename T, typename Op, omp_sched_t Schedule, bool Aligned>
+void BLAS1_complex_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ; 
+	T a = static_cast<T>(2.0) ;
+	omp_run run(state, Schedule) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* vec3 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* vec4 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* result = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	run.parallel_for(vector_size, [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			vec1[i] = 1;
+			vec2[i] = 2;
+			vec3[i] = 3;
+			vec4[i] = 4;
+			result[i] = 0;
+		}
+	}) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			result[i] = operation(a, vec1[i], vec2[i], vec3[i], vec4[i]) ;
+		}
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(vec3);
+	std::free(vec4);
+	std::free(result);
+	run.report(state, vector_size, 5 * sizeof(T)) ;
+}
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// BLAS1_complex_intrinsics (aligned, Unroll = 4) on each block : blocks start on a 64-element boundary
+template <typename ISA, omp_sched_t Schedule>
+void BLAS1_complex_intrinsics_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	omp_run run(state, Schedule) ;
+	simd_buffer<float> vec1(vector_size, true, 1) ;
+	simd_buffer<float> vec2(vector_size, true, 2) ;
+	simd_buffer<float> vec3(vector_size, true, 3) ;
+	simd_buffer<float> vec4(vector_size, true, 4) ;
+	simd_buffer<float> result(vector_size, true, 0) ;
+	const typename ISA::reg a = ISA::set1(2.0f) ;
+	auto op = [a](typename ISA::reg v1, typename ISA::reg v2, typename ISA::reg v3, typename ISA::reg v4) {
+		return ISA::fmadd(a, v1, ISA::mul(ISA::mul(v2, v3), v4)) ;
+	} ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		simd_map<ISA, true, 4>(result.data() + first, last - first, op, vec1.data() + first, vec2.data() + first, vec3.data() + first, vec4.data() + first) ;
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	run.report(state, vector_size, 5 * sizeof(float)) ;
+}
+#endif
+#endif
 
 template <typename T, typename Op>
 void BLAS1_complex_std_vector(benchmark::State& state) {
@@ -135,6 +390,26 @@ void BLAS1_complex_std_vector(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// allocate + produce result : std::vector<T>(n) (zero-fill + kernel) or uninitialized_vector<T>(n) (kernel only)
+template <typename T, typename Op, typename Vector>
+void BLAS1_complex_alloc(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation;
+	T a = static_cast<T>(2.0) ;
+	std::vector<T> vec1(vector_size, 1);
+	std::vector<T> vec2(vector_size, 2);
+	std::vector<T> vec3(vector_size, 3);
+	std::vector<T> vec4(vector_size, 4);
+	for (auto _ : state) {
+		Vector result(vector_size);
+		for (int i = 0; i < vector_size; ++i) {
+			result[i] = operation(a, vec1[i] , vec2[i], vec3[i] , vec4[i]) ;
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
 #ifdef XBENCHMARK_USE_XTENSOR
 template <typename T, typename Op>
 void BLAS1_complex_xarray(benchmark::State& state) {
@@ -150,6 +425,8 @@ void BLAS1_complex_xarray(benchmark::State& state) {
 	vec3.fill(3) ; 
 	vec4.fill(4) ; 
 	result.fill(0) ; 
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		// lot of constexpr because of xtensor itself
 		if constexpr(std::is_same_v<Op, complex_op<T>>){
@@ -157,7 +434,9 @@ void BLAS1_complex_xarray(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -230,13 +509,51 @@ void BLAS1_complex_xtensor_eval(benchmark::State& state) {
 	vec3.fill(3) ; 
 	vec4.fill(4) ; 
 	result.fill(0);
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		if constexpr(std::is_same_v<Op, complex_op<T>>){
 			xt::noalias(result) = xt::eval(a * vec1 + vec2 * vec3 * vec4);
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// Same as BLAS1_complex_xtensor_eval, the temporary comes from the caching pool (caching_allocator.hpp).
+// Counter pool_misses : allocations that reached the system, per iteration.
+template <typename T, typename Op>
+void BLAS1_complex_xtensor_eval_caching(benchmark::State& state) {
+	const unsigned long vector_size = state.range(0);
+	T a = static_cast<T>(2.0) ;
+	xt::xtensor<T, 1> vec1   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> vec2   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> vec3   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> vec4   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> result = xt::xtensor<T,1>::from_shape({vector_size});
+	vec1.fill(1);
+	vec2.fill(2);
+	vec3.fill(3) ;
+	vec4.fill(4) ;
+	result.fill(0);
+	caching_pool& pool = caching_pool::local() ;
+	const std::size_t misses = pool.misses() ;
+	heap_counter allocations ;
+	allocations.start() ;
+	for (auto _ : state) {
+		if constexpr(std::is_same_v<Op, complex_op<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(a * vec1 + vec2 * vec3 * vec4);
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["pool_misses"] = static_cast<double>(pool.misses() - misses) / state.iterations() ;
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -255,6 +572,8 @@ void BLAS1_complex_xtensor_auto_eval(benchmark::State& state) {
 	vec3.fill(3) ;
 	vec4.fill(4) ;
 	result.fill(0);
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		if constexpr(std::is_same_v<Op, complex_op<T>>){
 			auto eval = xt::eval(a * vec1 + vec2 * vec3 * vec4);
@@ -262,7 +581,9 @@ void BLAS1_complex_xtensor_auto_eval(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -282,13 +603,17 @@ void BLAS1_complex_xtensor_only_auto_eval(benchmark::State& state) {
 	vec3.fill(3) ;
 	vec4.fill(4) ;
 	result.fill(0);
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		if constexpr(std::is_same_v<Op, complex_op<T>>){
 			auto eval = xt::eval(a * vec1 + vec2 * vec3 * vec4);
 		}
 		//        benchmark::DoNotOptimize(eval);
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -299,17 +624,65 @@ void BLAS1_complex_xtensor_only_auto_eval(benchmark::State& state) {
 
 // Power of two rule
 BENCHMARK_TEMPLATE(BLAS1_complex_raw, float,	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK_TEMPLATE(BLAS1_complex_stdsimd, float,	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+BENCHMARK_TEMPLATE(BLAS1_complex_xsimd, float,	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_TEMPLATE(BLAS1_complex_aligned, float,	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_isa, float,	complex_op<	float>, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_isa, float,	complex_op<	float>, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_isa, float,	complex_op<	float>, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_dispatch, float,	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#ifdef XBENCHMARK_HAS_AVX2
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx2_isa, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx2_isa, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx2_isa, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx2_isa, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_HAS_AVX512
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx512_isa, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx512_isa, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx512_isa, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics, avx512_isa, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#endif
 BENCHMARK_TEMPLATE(BLAS1_complex_std_vector, float,		complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_alloc, float, complex_op<float>, std::vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_alloc, float, complex_op<float>, uninitialized_vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #ifdef XBENCHMARK_USE_XTENSOR
 BENCHMARK_TEMPLATE(BLAS1_complex_xarray, float, 	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_complex_xtensor, float,	complex_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_complex_xtensor_explicit, float,   complex_op<     float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_complex_xtensor_eval, float,        complex_op<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_complex_xtensor_eval_caching, float, complex_op<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_complex_xtensor_auto_eval, float,        complex_op<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_complex_xtensor_only_auto_eval, float,        complex_op<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #endif
 
+#ifdef XBENCHMARK_USE_OPENMP
+// chunk 0 (one block per thread) for static only
+BENCHMARK_TEMPLATE(BLAS1_complex_omp, float, complex_op<float>, omp_sched_static, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_omp, float, complex_op<float>, omp_sched_dynamic, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_omp, float, complex_op<float>, omp_sched_guided, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_omp, float, complex_op<float>, omp_sched_static, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_omp, float, complex_op<float>, omp_sched_dynamic, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_omp, float, complex_op<float>, omp_sched_guided, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#if defined(XBENCHMARK_HAS_AVX512)
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics_omp, avx512_isa, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics_omp, avx512_isa, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics_omp, avx512_isa, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#elif defined(XBENCHMARK_HAS_AVX2)
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics_omp, avx2_isa, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics_omp, avx2_isa, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_complex_intrinsics_omp, avx2_isa, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#endif
+#endif
+#endif
+
 BENCHMARK_MAIN();
 
 
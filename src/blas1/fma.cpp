@@ -17,6 +17,24 @@
 
 
 #include <utils/custom_arguments.hpp>
+#ifdef XBENCHMARK_USE_OPENMP
+#include <utils/omp_benchmark.hpp>
+#endif
+#include <blas1/isa_kernels.hpp>
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+#include <blas1/xsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#include <blas1/simd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_KOKKOS
+#include <utils/kokkos_benchmark.hpp>
+#endif
+#include <allocation/default_init_allocator.hpp>
+#include <utils/allocation_counter.hpp>
 
 int min = 1 ;
 int max = 1000000 ;
@@ -110,6 +128,194 @@ void BLAS1_fma_aligned(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// Plain loop compiled once per ISA level (include/blas1/isa_kernels.hpp) : the sse42 version
+// has no fma instruction, the avx2 / avx512 ones contract a * vec1 + vec2 into vfmadd
+template <typename T, typename Op, isa_level L>
+void BLAS1_fma_isa(benchmark::State& state) {
+	if (const char* reason = isa_unavailable(L)) {
+		state.SkipWithError(reason);
+		return;
+	}
+	const int vector_size = state.range(0);
+	const T a = 2.0 ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0 ;
+	}
+	for (auto _ : state) {
+		isa_kernels<L>::map(result, vector_size, [a](const T& x, const T& y) { return a * x + y ; }, vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+#ifdef XBENCHMARK_USE_STDSIMD
+// Portable SIMD with std::experimental::simd (include/blas1/stdsimd_kernels.hpp) : a * vec1 + vec2
+// on registers, contracted into fma by the compiler when the target has it
+template <typename T, typename Op>
+void BLAS1_fma_stdsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	const native_simd<T> a(static_cast<T>(2.0)) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0 ;
+	}
+	for (auto _ : state) {
+		stdsimd_map(result, vector_size, [a](const native_simd<T>& x, const native_simd<T>& y) { return a * x + y ; }, vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XSIMD
+// xsimd::batch written by hand (include/blas1/xsimd_kernels.hpp) : explicit xsimd::fma, the
+// same call as xtensor's fma_op on batches
+template <typename T, typename Op>
+void BLAS1_fma_xsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0 ;
+	}
+	auto kernel = [](const auto& x, const auto& y) {
+		using V = std::decay_t<decltype(x)> ;
+		return xsimd::fma(V(static_cast<T>(2.0)), x, y) ;
+	} ;
+	for (auto _ : state) {
+		xsimd_map(result, vector_size, kernel, vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// Hand-written AVX2 / AVX-512 kernel of result = a * vec1 + vec2, one fmadd per register
+// (include/blas1/simd_kernels.hpp). Aligned = false : arrays shifted by 4 bytes.
+template <typename ISA, bool Aligned, std::size_t Unroll>
+void BLAS1_fma_intrinsics(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	simd_buffer<float> vec1(vector_size, Aligned, 1) ;
+	simd_buffer<float> vec2(vector_size, Aligned, 2) ;
+	simd_buffer<float> result(vector_size, Aligned, 0) ;
+	const typename ISA::reg a = ISA::set1(2.0f) ;
+	for (auto _ : state) {
+		simd_map<ISA, Aligned, Unroll>(result.data(), vector_size, [a](typename ISA::reg x, typename ISA::reg y) { return ISA::fmadd(a, x, y) ; }, vec1.data(), vec2.data()) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+
+#ifdef XBENCHMARK_USE_OPENMP
+// BLAS1_fma_raw (Aligned = false, malloc) / BLAS1_fma_aligned (Aligned = true) split over OpenMP
+// threads (include/utils/omp_benchmark.hpp) : range(1) = threads, range(2) = chunk, Schedule =
+// omp_sched_static / dynamic / guided. Arrays first touched by the threads that compute them.
+template <typename T, typename Op, omp_sched_t Schedule, bool Aligned>
+void BLAS1_fma_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ; 
+	T a = static_cast<T>(2.0) ;
+	omp_run run(state, Schedule) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* result = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	run.parallel_for(vector_size, [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			vec1[i] = 1;
+			vec2[i] = 2;
+			result[i] = 0;
+		}
+	}) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			result[i] = operation(a, vec1[i], vec2[i]) ;
+		}
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(result);
+	run.report(state, vector_size, 3 * sizeof(T)) ;
+}
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// BLAS1_fma_intrinsics (aligned, Unroll = 4) on each block : blocks start on a 64-element boundary
+template <typename ISA, omp_sched_t Schedule>
+void BLAS1_fma_intrinsics_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	omp_run run(state, Schedule) ;
+	simd_buffer<float> vec1(vector_size, true, 1) ;
+	simd_buffer<float> vec2(vector_size, true, 2) ;
+	simd_buffer<float> result(vector_size, true, 0) ;
+	const typename ISA::reg a = ISA::set1(2.0f) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		simd_map<ISA, true, 4>(result.data() + first, last - first, [a](typename ISA::reg x, typename ISA::reg y) { return ISA::fmadd(a, x, y) ; }, vec1.data() + first, vec2.data() + first) ;
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	run.report(state, vector_size, 3 * sizeof(float)) ;
+}
+#endif
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+// Kokkos::View + parallel_for on the execution space Space (include/utils/kokkos_benchmark.hpp)
+template <typename T, typename Op, typename Space>
+void BLAS1_fma_kokkos(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ;
+	const T a = static_cast<T>(2.0) ;
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::View<T*, Space> result("result", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		Kokkos::parallel_for("BLAS1_fma_kokkos", Kokkos::RangePolicy<Space>(0, vector_size), KOKKOS_LAMBDA(const int i) {
+			result(i) = operation(a, vec1(i), vec2(i)) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(kokkos_label<Space>());
+}
+#endif
 
 template <typename T, typename Op>
 void BLAS1_fma_std_vector(benchmark::State& state) {
@@ -128,6 +334,24 @@ void BLAS1_fma_std_vector(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// allocate + produce result : std::vector<T>(n) (zero-fill + kernel) or uninitialized_vector<T>(n) (kernel only)
+template <typename T, typename Op, typename Vector>
+void BLAS1_fma_alloc(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation;
+	T a = static_cast<T>(2.0) ;
+	std::vector<T> vec1(vector_size, 1);
+	std::vector<T> vec2(vector_size, 2);
+	for (auto _ : state) {
+		Vector result(vector_size);
+		for (int i = 0; i < vector_size; ++i) {
+			result[i] = operation(a, vec1[i] , vec2[i]) ;
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
 #ifdef XBENCHMARK_USE_XTENSOR
 template <typename T, typename Op>
 void BLAS1_fma_xarray(benchmark::State& state) {
@@ -139,13 +363,17 @@ void BLAS1_fma_xarray(benchmark::State& state) {
 	vec1.fill(1) ; 
 	vec2.fill(2) ; 
 	result.fill(0) ; 
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		if constexpr(std::is_same_v<Op, fma_op<T>>){
 			xt::noalias(result) = a * vec1 + vec2;
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -181,13 +409,17 @@ void BLAS1_fma_xtensor_eval(benchmark::State& state) {
 	vec1.fill(1);
 	vec2.fill(2);
 	result.fill(0);
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		if constexpr(std::is_same_v<Op, fma_op<T>>){
 			xt::noalias(result) = xt::eval(a * vec1 + vec2);
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -197,14 +429,73 @@ void BLAS1_fma_xtensor_eval(benchmark::State& state) {
 
 // Power of two rule
 BENCHMARK_TEMPLATE(BLAS1_fma_raw, float,	fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_isa, float,	fma_op<	float>, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_isa, float,	fma_op<	float>, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_isa, float,	fma_op<	float>, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK_TEMPLATE(BLAS1_fma_stdsimd, float,	fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+BENCHMARK_TEMPLATE(BLAS1_fma_xsimd, float,	fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_TEMPLATE(BLAS1_fma_aligned, float,	fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#ifdef XBENCHMARK_HAS_AVX2
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx2_isa, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx2_isa, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx2_isa, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx2_isa, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_HAS_AVX512
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx512_isa, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx512_isa, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx512_isa, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics, avx512_isa, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#endif
 BENCHMARK_TEMPLATE(BLAS1_fma_std_vector, float,		fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_alloc, float, fma_op<float>, std::vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_fma_alloc, float, fma_op<float>, uninitialized_vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #ifdef XBENCHMARK_USE_XTENSOR
 BENCHMARK_TEMPLATE(BLAS1_fma_xarray, float, 	fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_fma_xtensor, float,	fma_op<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_fma_xtensor_eval, float, fma_op< float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #endif
+#ifdef XBENCHMARK_USE_OPENMP
+// chunk 0 (one block per thread) for static only
+BENCHMARK_TEMPLATE(BLAS1_fma_omp, float, fma_op<float>, omp_sched_static, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_omp, float, fma_op<float>, omp_sched_dynamic, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_omp, float, fma_op<float>, omp_sched_guided, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_omp, float, fma_op<float>, omp_sched_static, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_omp, float, fma_op<float>, omp_sched_dynamic, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_omp, float, fma_op<float>, omp_sched_guided, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#if defined(XBENCHMARK_HAS_AVX512)
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics_omp, avx512_isa, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics_omp, avx512_isa, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics_omp, avx512_isa, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#elif defined(XBENCHMARK_HAS_AVX2)
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics_omp, avx2_isa, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics_omp, avx2_isa, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_fma_intrinsics_omp, avx2_isa, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#endif
+#endif
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+#ifdef KOKKOS_ENABLE_SERIAL
+BENCHMARK_TEMPLATE(BLAS1_fma_kokkos, float, fma_op<float>, Kokkos::Serial)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+BENCHMARK_TEMPLATE(BLAS1_fma_kokkos, float, fma_op<float>, Kokkos::OpenMP)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+XBENCHMARK_KOKKOS_MAIN();
+#else
 BENCHMARK_MAIN();
+#endif
 
 
 
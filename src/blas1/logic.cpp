@@ -21,6 +21,15 @@
 
 
 #include <utils/custom_arguments.hpp>
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+#include <blas1/xsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#include <blas1/simd_kernels.hpp>
+#endif
 
 int min = 1 ;
 int max = 1000000 ;
@@ -100,6 +109,75 @@ void BLAS1_op_aligned(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+#ifdef XBENCHMARK_USE_STDSIMD
+// Portable SIMD with std::experimental::simd (include/blas1/stdsimd_kernels.hpp) : the compare
+// gives a simd mask, stored as bool with simd_mask::copy_to
+template <typename T, typename Op>
+void BLAS1_op_stdsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	bool* result = static_cast<bool*>(std::aligned_alloc(alignment, vector_size * sizeof(bool)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	for (auto _ : state) {
+		stdsimd_compare(vec1, vec2, result, vector_size, stdsimd_op<Op>()) ;
+		benchmark::DoNotOptimize(result); // compiler artifice 
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XSIMD
+// xsimd::batch written by hand (include/blas1/xsimd_kernels.hpp) : the compare gives a
+// batch_bool, stored as bool
+template <typename T, typename Op>
+void BLAS1_op_xsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	bool* result = static_cast<bool*>(std::aligned_alloc(alignment, vector_size * sizeof(bool)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	for (auto _ : state) {
+		xsimd_compare(vec1, vec2, result, vector_size, xsimd_op<Op>()) ;
+		benchmark::DoNotOptimize(result); // compiler artifice 
+	}
+	std::free(vec1);
+	std::free(vec2);
+	std::free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// Hand-written AVX2 / AVX-512 kernel of vec1 < vec2 on int, one bool per element
+// (include/blas1/simd_kernels.hpp) : compare, then the lane mask is spread to bytes.
+// Aligned = false : arrays shifted by one element (4 bytes for the int32 inputs, 1 byte for the
+// bool result).
+template <typename ISA, bool Aligned, std::size_t Unroll>
+void BLAS1_less_intrinsics(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	simd_buffer<int> vec1(vector_size, Aligned, 1) ;
+	simd_buffer<int> vec2(vector_size, Aligned, 2) ;
+	simd_buffer<bool> result(vector_size, Aligned, false) ;
+	for (auto _ : state) {
+		simd_less<ISA, Aligned, Unroll>(vec1.data(), vec2.data(), result.data(), vector_size) ;
+		benchmark::DoNotOptimize(result.data()); // compiler artifice 
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
 
 template <typename T, typename Op>
 void BLAS1_op_std_vector(benchmark::State& state) {
@@ -272,7 +350,27 @@ void BLAS1_op_xtensor_fixed_noalias(benchmark::State& state) {
 
 // Power of two rule
 BENCHMARK_TEMPLATE(BLAS1_op_raw, int,	std::less<	int>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK_TEMPLATE(BLAS1_op_stdsimd, int,	std::less<	int>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+BENCHMARK_TEMPLATE(BLAS1_op_xsimd, int,	std::less<	int>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_TEMPLATE(BLAS1_op_aligned, int,	std::less<	int>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#ifdef XBENCHMARK_HAS_AVX2
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx2_isa, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx2_isa, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx2_isa, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx2_isa, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_HAS_AVX512
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx512_isa, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx512_isa, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx512_isa, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_less_intrinsics, avx512_isa, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#endif
 BENCHMARK_TEMPLATE(BLAS1_op_std_vector, int,		std::less<	int>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #ifdef XBENCHMARK_USE_XTENSOR
 BENCHMARK_TEMPLATE(BLAS1_op_xarray, int, 	std::less<	int>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 #include <vector>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include <functional>             
 #include <type_traits>           
@@ -13,6 +17,7 @@
 #include <xtensor/xio.hpp>
 #include <xtensor/xoperation.hpp>
 #include <xtensor/xmath.hpp>
+#include <xtensor/xbuilder.hpp>
 #endif
 
 
@@ -22,6 +27,28 @@
 
 
 #include <utils/custom_arguments.hpp>
+#ifdef XBENCHMARK_USE_OPENMP
+#include <utils/omp_benchmark.hpp>
+#endif
+#include <blas1/isa_kernels.hpp>
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+#include <blas1/xsimd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#include <blas1/simd_kernels.hpp>
+#endif
+#ifdef XBENCHMARK_USE_KOKKOS
+#include <utils/kokkos_benchmark.hpp>
+#endif
+#include <utils/perf_counter.hpp>
+#include <utils/allocation_counter.hpp>
+#include <allocation/huge_pages.hpp>
+#include <utils/numa_benchmark.hpp>
+#include <allocation/default_init_allocator.hpp>
+#include <allocation/caching_allocator.hpp>
 
 int min = 1 ;
 int max = 1000000 ;
@@ -33,6 +60,8 @@ const int MS = 1 ; // Min_size of arrays
 const int RM = 2 ; /// RangeMultiplier
 const int PS = 21 ; // pow size
 
+int ncores = std::max(1u, std::thread::hardware_concurrency()) ;
+
 
 // Note : I cant just use Operations like std::plus<> to reduce code size because I can't 
 // achieve to use it with XTensor in limited time.
@@ -50,11 +79,15 @@ void BLAS1_op_eigen_matrix(benchmark::State& state){
         Eigen::Matrix<T, Eigen::Dynamic, 1>  result(vector_size) ;
 
 
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state){
 		result = vec1.binaryExpr(vec2, operation);
                 benchmark::DoNotOptimize(result); // compiler artifice 
         }
+	allocations.stop() ;
         state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -89,9 +122,10 @@ void BLAS1_op_aligned(benchmark::State& state) {
 	Op operation ; 
 	constexpr std::size_t alignment = 64; 
 
-	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	// 4 KB or huge pages according to XBENCHMARK_PAGES (aligned_alloc by default)
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
 	for (int i = 0; i < vector_size; ++i) {
 		vec1[i] = 1;
 		vec2[i] = 2;
@@ -104,12 +138,364 @@ void BLAS1_op_aligned(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
 	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// Plain loop compiled once per ISA level (include/blas1/isa_kernels.hpp), skipped when the
+// CPU, XBENCHMARK_ISA or the build baseline does not allow level L : with
+// -DXBENCHMARK_PORTABLE=ON, the three levels side by side from one binary
+template <typename T, typename Op, isa_level L>
+void BLAS1_op_isa(benchmark::State& state) {
+	if (const char* reason = isa_unavailable(L)) {
+		state.SkipWithError(reason);
+		return;
+	}
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	for (auto _ : state) {
+		isa_kernels<L>::map(result, vector_size, Op(), vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// Same loop, version chosen at run time (best level of the CPU, capped by XBENCHMARK_ISA)
+template <typename T, typename Op>
+void BLAS1_op_dispatch(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	// resolved once, as an ifunc resolver would do
+	void (*op)(T*, std::size_t, Op, const T*, const T*) = dispatch_isa(active_isa(), [](auto level) {
+		return &isa_kernels<decltype(level)::value>::template map<T, Op, T, T> ;
+	}) ;
+	for (auto _ : state) {
+		op(result, vector_size, Op(), vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(isa_name(active_isa()));
+}
+
+#ifdef XBENCHMARK_USE_STDSIMD
+// Portable SIMD with std::experimental::simd (include/blas1/stdsimd_kernels.hpp) : native_simd<T>
+// registers, masked tail with where()
+template <typename T, typename Op>
+void BLAS1_op_stdsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	for (auto _ : state) {
+		stdsimd_map(result, vector_size, stdsimd_op<Op>(), vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XSIMD
+// xsimd::batch written by hand (include/blas1/xsimd_kernels.hpp) : the SIMD code of
+// BLAS1_op_xtensor_aligned_64 without the xtensor expression and assignment layer
+template <typename T, typename Op>
+void BLAS1_op_xsimd(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	for (auto _ : state) {
+		xsimd_map(result, vector_size, xsimd_op<Op>(), vec1, vec2) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// Hand-written AVX2 / AVX-512 kernel (include/blas1/simd_kernels.hpp), float only : upper bound
+// for the auto-vectorised loop of BLAS1_op_aligned. Aligned = false runs unaligned loads and
+// stores on arrays shifted by 4 bytes ; Unroll = registers per loop iteration ; masked tail.
+template <typename ISA, typename Op, bool Aligned, std::size_t Unroll>
+void BLAS1_op_intrinsics(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	simd_buffer<float> vec1(vector_size, Aligned, 1) ;
+	simd_buffer<float> vec2(vector_size, Aligned, 2) ;
+	simd_buffer<float> result(vector_size, Aligned, 0) ;
+	for (auto _ : state) {
+		simd_map<ISA, Aligned, Unroll>(result.data(), vector_size, simd_op<ISA, Op>::apply, vec1.data(), vec2.data()) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+
+// Same kernel on arrays backed by 4 KB pages (small), transparent huge pages (huge)
+// or reserved huge pages (hugetlb). Large arrays only : beyond a few MB, the 4 KB
+// pages do not fit in the TLB anymore.
+// huge_bytes : bytes really backed by huge pages, dtlb_misses : dTLB misses per element
+// (when perf_event_open is allowed).
+template <typename T, typename Op, page_mode Mode>
+void BLAS1_op_pages(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ;
+
+	const std::size_t huge_before = anon_huge_page_bytes() ;
+	T* vec1 = page_alloc<T>(vector_size, Mode);
+	T* vec2 = page_alloc<T>(vector_size, Mode);
+	T* result = page_alloc<T>(vector_size, Mode);
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0;
+	}
+	const std::size_t huge_bytes = anon_huge_page_bytes() - huge_before ;
+
+	perf_counter dtlb = dtlb_load_misses() ;
+	dtlb.start() ;
+	for (auto _ : state) {
+		for (int i = 0; i < vector_size; ++i) {
+			result[i] = operation(vec1[i] , vec2[i]) ;
+		}
+		benchmark::DoNotOptimize(result);
+	}
+	dtlb.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["huge_bytes"] = huge_bytes ;
+	state.counters["page_mode"] = static_cast<int>(allocated_page_mode(vec1)) ;
+	if (dtlb.available()) {
+		state.counters["dtlb_misses"] = static_cast<double>(dtlb.value()) / (state.iterations() * vector_size) ;
+	}
+	page_free(vec1);
+	page_free(vec2);
+	page_free(result);
+}
+
+// Reads at random indices : every access may hit a different page, this is the case
+// most sensitive to the page size.
+template <typename T, page_mode Mode>
+void BLAS1_gather_pages(benchmark::State& state) {
+	const int vector_size = state.range(0);
+
+	const std::size_t huge_before = anon_huge_page_bytes() ;
+	T* vec1 = page_alloc<T>(vector_size, Mode);
+	T* result = page_alloc<T>(vector_size, Mode);
+	int* index = page_alloc<int>(vector_size, Mode);
+	std::mt19937 gen(1234) ;
+	std::uniform_int_distribution<int> distrib(0, vector_size - 1) ;
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		result[i] = 0;
+		index[i] = distrib(gen) ;
+	}
+	const std::size_t huge_bytes = anon_huge_page_bytes() - huge_before ;
+
+	perf_counter dtlb = dtlb_load_misses() ;
+	dtlb.start() ;
+	for (auto _ : state) {
+		for (int i = 0; i < vector_size; ++i) {
+			result[i] = vec1[index[i]] ;
+		}
+		benchmark::DoNotOptimize(result);
+	}
+	dtlb.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["huge_bytes"] = huge_bytes ;
+	state.counters["page_mode"] = static_cast<int>(allocated_page_mode(vec1)) ;
+	if (dtlb.available()) {
+		state.counters["dtlb_misses"] = static_cast<double>(dtlb.value()) / (state.iterations() * vector_size) ;
+	}
+	page_free(vec1);
+	page_free(result);
+	page_free(index);
+}
+
+
+// Multi-threaded c = a + b on arrays shared by all the threads, each thread computing its
+// own chunk. range(1) selects the numa_policy of the pages, range(2) the thread_placement
+// (see include/allocation/numa.hpp). Placement is done once per run, outside of the timing.
+template <typename T, typename Op>
+void BLAS1_op_numa(benchmark::State& state) {
+	static std::atomic<numa_shared<T>*> shared {nullptr} ;
+	Op operation ;
+	numa_thread<T> thread(state, shared, state.range(0), {1, 2, 0}) ;
+	const T* vec1 = thread.array(0) ;
+	const T* vec2 = thread.array(1) ;
+	T* result = thread.array(2) ;
+	for (auto _ : state) {
+		for (std::size_t i = thread.first(); i < thread.last(); ++i) {
+			result[i] = operation(vec1[i], vec2[i]) ;
+		}
+		benchmark::DoNotOptimize(result);
+	}
+	thread.report(state, 3 * sizeof(T)) ;
+}
+
+#ifdef XBENCHMARK_USE_OPENMP
+// BLAS1_op_raw (Aligned = false, malloc) / BLAS1_op_aligned (Aligned = true) split over OpenMP
+// threads (include/utils/omp_benchmark.hpp) : range(1) = threads, range(2) = chunk, Schedule =
+// omp_sched_static / dynamic / guided. Arrays first touched by the threads that compute them.
+template <typename T, typename Op, omp_sched_t Schedule, bool Aligned>
+void BLAS1_op_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ; 
+	omp_run run(state, Schedule) ;
+	constexpr std::size_t alignment = 64; 
+	T* vec1 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	T* result = static_cast<T*>(Aligned ? std::aligned_alloc(alignment, vector_size * sizeof(T)) : std::malloc(vector_size * sizeof(T)));
+	run.parallel_for(vector_size, [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			vec1[i] = 1;
+			vec2[i] = 2;
+			result[i] = 0;
+		}
+	}) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			result[i] = operation(vec1[i], vec2[i]) ;
+		}
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
 	std::free(vec1);
 	std::free(vec2);
 	std::free(result);
+	run.report(state, vector_size, 3 * sizeof(T)) ;
+}
+
+#ifdef XBENCHMARK_USE_IMMINTRIN
+// BLAS1_op_intrinsics (aligned, Unroll = 4) on each block : blocks start on a 64-element boundary
+template <typename ISA, typename Op, omp_sched_t Schedule>
+void BLAS1_op_intrinsics_omp(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	omp_run run(state, Schedule) ;
+	simd_buffer<float> vec1(vector_size, true, 1) ;
+	simd_buffer<float> vec2(vector_size, true, 2) ;
+	simd_buffer<float> result(vector_size, true, 0) ;
+	auto kernel = [&](std::size_t first, std::size_t last) {
+		simd_map<ISA, true, 4>(result.data() + first, last - first, simd_op<ISA, Op>::apply, vec1.data() + first, vec2.data() + first) ;
+	} ;
+	run.measure_serial(vector_size, kernel) ;
+	for (auto _ : state) {
+		run.parallel_for(vector_size, kernel) ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	run.report(state, vector_size, 3 * sizeof(float)) ;
+}
+#endif
+#endif
+
+// Dot product : sum of vec1[i] * vec2[i]. The sum is done in order (no -ffast-math), the loop
+// is not vectorised : this is the serial reference of BLAS1_dot_kokkos.
+template <typename T>
+void BLAS1_dot_raw(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	T* vec1 = static_cast<T*>(std::malloc(vector_size * sizeof(T)));
+	T* vec2 = static_cast<T*>(std::malloc(vector_size * sizeof(T)));
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+	}
+	for (auto _ : state) {
+		T sum = 0 ;
+		for (int i = 0; i < vector_size; ++i) {
+			sum += vec1[i] * vec2[i] ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	free(vec1) ;
+	free(vec2) ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetBytesProcessed(state.iterations() * vector_size * 2 * sizeof(T));
 }
 
+#ifdef XBENCHMARK_USE_KOKKOS
+// Kokkos::View + parallel_for on the execution space Space (include/utils/kokkos_benchmark.hpp) :
+// same kernel as BLAS1_op_raw, the difference is the cost of the View accessors and of the
+// parallel dispatch. 1D Views have the same layout whatever LayoutLeft / LayoutRight.
+template <typename T, typename Op, typename Space>
+void BLAS1_op_kokkos(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation ;
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::View<T*, Space> result("result", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		Kokkos::parallel_for("BLAS1_op_kokkos", Kokkos::RangePolicy<Space>(0, vector_size), KOKKOS_LAMBDA(const int i) {
+			result(i) = operation(vec1(i), vec2(i)) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(kokkos_label<Space>());
+}
+
+// Dot product with parallel_reduce : each thread sums its range, the partial sums are then
+// combined. Reference : BLAS1_dot_raw.
+template <typename T, typename Space>
+void BLAS1_dot_kokkos(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		T sum = 0 ;
+		Kokkos::parallel_reduce("BLAS1_dot_kokkos", Kokkos::RangePolicy<Space>(0, vector_size), KOKKOS_LAMBDA(const int i, T& partial) {
+			partial += vec1(i) * vec2(i) ;
+		}, sum);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetBytesProcessed(state.iterations() * vector_size * 2 * sizeof(T));
+	state.SetLabel(kokkos_label<Space>());
+}
+#endif
 
 template <typename T, typename Op>
 void BLAS1_op_std_vector(benchmark::State& state) {
@@ -127,6 +513,58 @@ void BLAS1_op_std_vector(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
+// "allocate + produce result" : the result is allocated inside the timed loop, as for an
+// expression returning a new array. std::vector<T>(n) writes zeros before the kernel writes
+// the result (two passes over the result), uninitialized_vector<T>(n) a single one.
+template <typename T, typename Op, typename Vector>
+void BLAS1_op_alloc(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Op operation;
+	std::vector<T> vec1(vector_size, 1);
+	std::vector<T> vec2(vector_size, 2);
+	for (auto _ : state) {
+		Vector result(vector_size);
+		for (int i = 0; i < vector_size; ++i) {
+			result[i] = operation(vec1[i] , vec2[i]) ;
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// same with xtensor : xt::zeros (fill + kernel) against uninitialized_xtensor (kernel only)
+template <typename T>
+void BLAS1_op_alloc_xtensor_zeros(benchmark::State& state) {
+	const unsigned long vector_size = state.range(0);
+	xt::xtensor<T, 1> vec1 = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> vec2 = xt::xtensor<T,1>::from_shape({vector_size});
+	vec1.fill(1);
+	vec2.fill(2);
+	for (auto _ : state) {
+		xt::xtensor<T, 1> result = xt::zeros<T>({vector_size});
+		xt::noalias(result) = vec1 + vec2;
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+template <typename T>
+void BLAS1_op_alloc_uninitialized_xtensor(benchmark::State& state) {
+	const unsigned long vector_size = state.range(0);
+	xt::xtensor<T, 1> vec1 = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> vec2 = xt::xtensor<T,1>::from_shape({vector_size});
+	vec1.fill(1);
+	vec2.fill(2);
+	for (auto _ : state) {
+		uninitialized_xtensor<T, 1> result = uninitialized_xtensor<T, 1>::from_shape({vector_size});
+		xt::noalias(result) = vec1 + vec2;
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
 #ifdef XBENCHMARK_USE_XTENSOR
 template <typename T, typename Op>
 void BLAS1_op_xarray(benchmark::State& state) {
@@ -138,6 +576,8 @@ void BLAS1_op_xarray(benchmark::State& state) {
 	vec2.fill(2.0);
 //vec1 = 1.0 ; 
 //	vec2 = 2.0 ; 
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		// lot of constexpr because of xtensor itself
 		if constexpr(std::is_same_v<Op, std::plus<T>>){
@@ -151,7 +591,9 @@ void BLAS1_op_xarray(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -283,6 +725,8 @@ void BLAS1_op_xtensor_eval(benchmark::State& state) {
 	vec1.fill(1);
 	vec2.fill(2);
 	result.fill(0);
+	heap_counter allocations ;
+	allocations.start() ;
 	for (auto _ : state) {
 		// lots of constexpr becaus of xtensor itself
 		if constexpr(std::is_same_v<Op, std::plus<T>>){
@@ -296,7 +740,77 @@ void BLAS1_op_xtensor_eval(benchmark::State& state) {
 		}
 		benchmark::DoNotOptimize(result.data());
 	}
+	allocations.stop() ;
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	report_heap_allocations(state, allocations) ;
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// Same as BLAS1_op_xarray, the temporary of xt::eval comes from the caching pool (caching_allocator.hpp).
+// Counter pool_misses : allocations that reached the system, per iteration.
+template <typename T, typename Op>
+void BLAS1_op_xarray_caching(benchmark::State& state) {
+	const unsigned long vector_size = static_cast<unsigned long>(state.range(0));
+	xt::xarray<T> vec1 = xt::xarray<T>::from_shape({vector_size});
+	xt::xarray<T> vec2 = xt::xarray<T>::from_shape({vector_size});
+	xt::xarray<T> result = xt::xarray<T>::from_shape({vector_size});
+	vec1.fill(1.0) ;
+	vec2.fill(2.0);
+	caching_pool& pool = caching_pool::local() ;
+	const std::size_t misses = pool.misses() ;
+	heap_counter allocations ;
+	allocations.start() ;
+	for (auto _ : state) {
+		if constexpr(std::is_same_v<Op, std::plus<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 + vec2);
+		} else if constexpr(std::is_same_v<Op, std::minus<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 - vec2);
+		} else if constexpr(std::is_same_v<Op, std::multiplies<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 * vec2);
+		} else if constexpr(std::is_same_v<Op, std::divides<T>>){
+			xt::noalias(result) = caching_xarray<T>(vec1 / vec2);
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	allocations.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["pool_misses"] = static_cast<double>(pool.misses() - misses) / state.iterations() ;
+	report_heap_allocations(state, allocations) ;
+}
+#endif
+
+#ifdef XBENCHMARK_USE_XTENSOR
+// Same as BLAS1_op_xtensor_eval, the temporary comes from the caching pool.
+template <typename T, typename Op>
+void BLAS1_op_xtensor_eval_caching(benchmark::State& state) {
+	const unsigned long vector_size = state.range(0);
+	xt::xtensor<T, 1> vec1   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> vec2   = xt::xtensor<T,1>::from_shape({vector_size});
+	xt::xtensor<T, 1> result = xt::xtensor<T,1>::from_shape({vector_size});
+	vec1.fill(1);
+	vec2.fill(2);
+	result.fill(0);
+	caching_pool& pool = caching_pool::local() ;
+	const std::size_t misses = pool.misses() ;
+	heap_counter allocations ;
+	allocations.start() ;
+	for (auto _ : state) {
+		if constexpr(std::is_same_v<Op, std::plus<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 + vec2);
+		} else if constexpr(std::is_same_v<Op, std::minus<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 - vec2);
+		} else if constexpr(std::is_same_v<Op, std::multiplies<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 * vec2);
+		} else if constexpr(std::is_same_v<Op, std::divides<T>>){
+			xt::noalias(result) = caching_xtensor<T, 1>(vec1 / vec2);
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	allocations.stop() ;
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.counters["pool_misses"] = static_cast<double>(pool.misses() - misses) / state.iterations() ;
+	report_heap_allocations(state, allocations) ;
 }
 #endif
 
@@ -345,10 +859,46 @@ BENCHMARK_TEMPLATE(BLAS1_op_eigen_matrix, float, std::plus< float>)->Apply([](be
 BENCHMARK_TEMPLATE(BLAS1_op_raw, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 //BENCHMARK_TEMPLATE(BLAS1_op_raw, float,	std::multiplies<float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 //BENCHMARK_TEMPLATE(BLAS1_op_raw, float,	std::divides<	float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK_TEMPLATE(BLAS1_op_stdsimd, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_USE_XSIMD
+BENCHMARK_TEMPLATE(BLAS1_op_xsimd, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_TEMPLATE(BLAS1_op_aligned, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_isa, float,	std::plus<	float>, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_isa, float,	std::plus<	float>, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_isa, float,	std::plus<	float>, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_dispatch, float,	std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 //BENCHMARK_TEMPLATE(BLAS1_op_aligned, float,	std::multiplies<float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 //BENCHMARK_TEMPLATE(BLAS1_op_aligned, float,	std::divides<	float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#ifdef XBENCHMARK_HAS_AVX2
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx2_isa, std::plus<float>, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#ifdef XBENCHMARK_HAS_AVX512
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, true, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, true, 2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, true, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics, avx512_isa, std::plus<float>, false, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+#endif
 BENCHMARK_TEMPLATE(BLAS1_op_std_vector, float,		std::plus<	float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_dot_raw, float)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+// large arrays only : from 256 KB to 256 MB per array
+BENCHMARK_TEMPLATE(BLAS1_op_pages, float, std::plus<float>, page_mode::small)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(BLAS1_op_pages, float, std::plus<float>, page_mode::huge)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(BLAS1_op_pages, float, std::plus<float>, page_mode::hugetlb)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(BLAS1_gather_pages, float, page_mode::small)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(BLAS1_gather_pages, float, page_mode::huge)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(BLAS1_gather_pages, float, page_mode::hugetlb)->RangeMultiplier(4)->Range(1 << 16, 1 << 26);
+BENCHMARK_TEMPLATE(BLAS1_op_alloc, float, std::plus<float>, std::vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_alloc, float, std::plus<float>, uninitialized_vector<float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+// 4 MB to 128 MB per array, from 1 thread to every core
+BENCHMARK_TEMPLATE(BLAS1_op_numa, float, std::plus<float>)->Apply([](benchmark::internal::Benchmark* b) {NumaArguments(b, {1 << 20, 1 << 23, 1 << 25});})->ThreadRange(1, ncores)->UseRealTime();
 //BENCHMARK_TEMPLATE(BLAS1_op_std_vector, float, 	std::multiplies<float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 //BENCHMARK_TEMPLATE(BLAS1_op_std_vector, float, 	std::divides<	float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 #ifdef XBENCHMARK_USE_XTENSOR
@@ -359,6 +909,8 @@ BENCHMARK_TEMPLATE(BLAS1_op_xtensor, float,	std::plus<	float>)->Apply([](benchma
 //BENCHMARK_TEMPLATE(BLAS1_op_xtensor, float,	std::multiplies<float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 //BENCHMARK_TEMPLATE(BLAS1_op_xtensor, float,	std::divides<	float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 //
+BENCHMARK_TEMPLATE(BLAS1_op_alloc_xtensor_zeros, float)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_alloc_uninitialized_xtensor, float)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 #ifdef XTENSOR_USE_XSIMD
 BENCHMARK_TEMPLATE(BLAS1_op_xtensor_aligned_64, float,     std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(BLAS1_op_xtensor_explicit_aligned, float,     std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
@@ -366,6 +918,8 @@ BENCHMARK_TEMPLATE(BLAS1_op_xtensor_explicit_aligned, float,     std::plus<
 BENCHMARK_TEMPLATE(BLAS1_op_xtensor_explicit, float,     std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 //
 BENCHMARK_TEMPLATE(BLAS1_op_xtensor_eval, float,        std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_xarray_caching, float,      std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(BLAS1_op_xtensor_eval_caching, float, std::plus<      float>)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 //BENCHMARK_TEMPLATE(BLAS1_op_xtensor_eval, float,        std::multiplies<float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 //BENCHMARK_TEMPLATE(BLAS1_op_xtensor_eval, float,        std::divides<   float>)->RangeMultiplier(RM)->Range(MS << 0, 1 << PS);
 
@@ -415,7 +969,43 @@ BENCHMARK_TEMPLATE(BLAS1_op_xtensor_fixed_noalias, 16384);
 
 
 
+#ifdef XBENCHMARK_USE_OPENMP
+// chunk 0 (one block per thread) for static only
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_static, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_dynamic, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_guided, false)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_static, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_dynamic, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_omp, float, std::plus<float>, omp_sched_guided, true)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#ifdef XBENCHMARK_USE_IMMINTRIN
+#if defined(XBENCHMARK_HAS_AVX512)
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx512_isa, std::plus<float>, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx512_isa, std::plus<float>, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx512_isa, std::plus<float>, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#elif defined(XBENCHMARK_HAS_AVX2)
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx2_isa, std::plus<float>, omp_sched_static)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {0, 4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx2_isa, std::plus<float>, omp_sched_dynamic)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+BENCHMARK_TEMPLATE(BLAS1_op_intrinsics_omp, avx2_isa, std::plus<float>, omp_sched_guided)->Apply([](benchmark::internal::Benchmark* b) {OmpArguments(b, {4096, 65536});});;
+#endif
+#endif
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+#ifdef KOKKOS_ENABLE_SERIAL
+BENCHMARK_TEMPLATE(BLAS1_op_kokkos, float, std::plus<float>, Kokkos::Serial)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(BLAS1_dot_kokkos, float, Kokkos::Serial)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+BENCHMARK_TEMPLATE(BLAS1_op_kokkos, float, std::plus<float>, Kokkos::OpenMP)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(BLAS1_dot_kokkos, float, Kokkos::OpenMP)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+XBENCHMARK_KOKKOS_MAIN();
+#else
 BENCHMARK_MAIN();
+#endif
 
 
 
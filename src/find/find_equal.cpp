@@ -10,6 +10,7 @@ const int RM = 4 ; /// RangeMultiplier
 const int PS = 8 ; // pow size
 
 #include <utils/custom_arguments.hpp>
+#include <allocation/huge_pages.hpp>
 int min = 1 ;
 int max = 100000 ;
 int threshold1 = 1024 ;
@@ -19,7 +20,7 @@ int threshold2 = 8096 ;
 
 void FIND_equal_naive(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) malloc(sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size, 16) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -28,13 +29,13 @@ void FIND_equal_naive(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);	
+        default_page_free(vector);	
 }
 
 
 void FIND_equal_no_break(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -43,14 +44,14 @@ void FIND_equal_no_break(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 
 
 void FIND_equal_compare(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -59,13 +60,13 @@ void FIND_equal_compare(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 
 void FIND_equal_std_find(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -74,12 +75,12 @@ void FIND_equal_std_find(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 void FIND_equal_std_lower_bound(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -88,18 +89,22 @@ void FIND_equal_std_lower_bound(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 
 
 void FIND_equal_intrinsic(benchmark::State& state){
         int size = state.range(0) ;
+        if (cpu_isa() < isa_level::avx2) {
+                state.SkipWithError("AVX2 not supported by the CPU") ;
+                return ;
+        }
         // !! AVX
         if (size < 8) {
                 size = 8 ;
         }
-        int* vector = (int*) malloc(sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size, 16) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -108,10 +113,68 @@ void FIND_equal_intrinsic(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
+}
+
+
+
+
+// one version per ISA level (include/blas1/isa_kernels.hpp), skipped when the CPU, XBENCHMARK_ISA
+// or the build baseline does not allow level L
+template <isa_level L>
+void FIND_equal_isa(benchmark::State& state){
+        if (const char* reason = isa_unavailable(L)) {
+                state.SkipWithError(reason) ;
+                return ;
+        }
+        const int size = state.range(0) ;
+        int* vector = default_page_alloc<int>(size) ;
+        int value = 1 ;
+        init_vector(vector, size, value, size-1);
+        int index ;
+        for (auto _ : state){
+                index = find_equal_isa<L>(vector, size, value);
+                benchmark::DoNotOptimize(index);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        default_page_free(vector);
 }
 
 
+// version chosen at run time : the best level of the CPU, capped by XBENCHMARK_ISA
+void FIND_equal_dispatch(benchmark::State& state){
+        const int size = state.range(0) ;
+        int* vector = default_page_alloc<int>(size) ;
+        int value = 1 ;
+        init_vector(vector, size, value, size-1);
+        // resolved once, as an ifunc resolver would do
+        int (*find)(int*, int, int) = dispatch_isa(active_isa(), [](auto level) { return &find_equal_isa<decltype(level)::value> ; }) ;
+        int index ;
+        for (auto _ : state){
+                index = find(vector, size, value);
+                benchmark::DoNotOptimize(index);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        state.SetLabel(isa_name(active_isa())) ;
+        default_page_free(vector);
+}
+
+
+#ifdef XBENCHMARK_USE_STDSIMD
+void FIND_equal_stdsimd(benchmark::State& state){
+        const int size = state.range(0) ;
+        int* vector = default_page_alloc<int>(size) ;
+        int value = 1 ;
+        init_vector(vector, size, value, size-1);
+        int index ;
+        for (auto _ : state){
+                index = find_equal_stdsimd(vector, size, value);
+                benchmark::DoNotOptimize(index);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        default_page_free(vector);
+}
+#endif
 
 
 BENCHMARK(FIND_equal_naive)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
@@ -120,5 +183,12 @@ BENCHMARK(FIND_equal_compare)->Apply([](benchmark::internal::Benchmark* b) {Cust
 BENCHMARK(FIND_equal_std_find)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK(FIND_equal_std_lower_bound)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK(FIND_equal_intrinsic)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(FIND_equal_isa, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(FIND_equal_isa, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(FIND_equal_isa, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK(FIND_equal_dispatch)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK(FIND_equal_stdsimd)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_MAIN() ; 
 
@@ -7,6 +7,7 @@
 
 
 #include <utils/custom_arguments.hpp>
+#include <allocation/huge_pages.hpp>
 int min = 1 ;
 int max = 1000000 ;
 int threshold1 = 1024 ;
@@ -22,7 +23,7 @@ const int PS = 8 ; // pow size
 
 void FIND_gt_naive(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) malloc(sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size, 16) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -31,13 +32,13 @@ void FIND_gt_naive(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);	
+        default_page_free(vector);	
 }
 
 
 void FIND_gt_no_break(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -46,14 +47,14 @@ void FIND_gt_no_break(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 
 
 void FIND_gt_compare(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -62,13 +63,13 @@ void FIND_gt_compare(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 
 void FIND_gt_std_find(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -77,12 +78,12 @@ void FIND_gt_std_find(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 void FIND_gt_std_lower_bound(benchmark::State& state){
         const int size = state.range(0) ;
-        int* vector = (int*) aligned_alloc(64, sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -91,18 +92,22 @@ void FIND_gt_std_lower_bound(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
 }
 
 
 
 void FIND_gt_intrinsic(benchmark::State& state){
         int size = state.range(0) ;
+        if (cpu_isa() < isa_level::avx2) {
+                state.SkipWithError("AVX2 not supported by the CPU") ;
+                return ;
+        }
         // !! AVX
         if (size < 8) {
                 size = 8 ;
         }
-        int* vector = (int*) malloc(sizeof(int) * size) ;
+        int* vector = default_page_alloc<int>(size, 16) ;
         int value = 1 ;
         init_vector(vector, size, value, size-1);
         int index ;
@@ -111,10 +116,68 @@ void FIND_gt_intrinsic(benchmark::State& state){
                 benchmark::DoNotOptimize(index);
         }
         state.SetItemsProcessed(state.iterations() * size);
-        free(vector);
+        default_page_free(vector);
+}
+
+
+
+
+// one version per ISA level (include/blas1/isa_kernels.hpp), skipped when the CPU, XBENCHMARK_ISA
+// or the build baseline does not allow level L
+template <isa_level L>
+void FIND_gt_isa(benchmark::State& state){
+        if (const char* reason = isa_unavailable(L)) {
+                state.SkipWithError(reason) ;
+                return ;
+        }
+        const int size = state.range(0) ;
+        int* vector = default_page_alloc<int>(size) ;
+        int value = 1 ;
+        init_vector(vector, size, value, size-1);
+        int index ;
+        for (auto _ : state){
+                index = find_gt_isa<L>(vector, size, value);
+                benchmark::DoNotOptimize(index);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        default_page_free(vector);
 }
 
 
+// version chosen at run time : the best level of the CPU, capped by XBENCHMARK_ISA
+void FIND_gt_dispatch(benchmark::State& state){
+        const int size = state.range(0) ;
+        int* vector = default_page_alloc<int>(size) ;
+        int value = 1 ;
+        init_vector(vector, size, value, size-1);
+        // resolved once, as an ifunc resolver would do
+        int (*find)(int*, int, int) = dispatch_isa(active_isa(), [](auto level) { return &find_gt_isa<decltype(level)::value> ; }) ;
+        int index ;
+        for (auto _ : state){
+                index = find(vector, size, value);
+                benchmark::DoNotOptimize(index);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        state.SetLabel(isa_name(active_isa())) ;
+        default_page_free(vector);
+}
+
+
+#ifdef XBENCHMARK_USE_STDSIMD
+void FIND_gt_stdsimd(benchmark::State& state){
+        const int size = state.range(0) ;
+        int* vector = default_page_alloc<int>(size) ;
+        int value = 1 ;
+        init_vector(vector, size, value, size-1);
+        int index ;
+        for (auto _ : state){
+                index = find_gt_stdsimd(vector, size, value);
+                benchmark::DoNotOptimize(index);
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+        default_page_free(vector);
+}
+#endif
 
 
 BENCHMARK(FIND_gt_naive)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
@@ -123,5 +186,12 @@ BENCHMARK(FIND_gt_compare)->Apply([](benchmark::internal::Benchmark* b) {CustomA
 BENCHMARK(FIND_gt_std_find)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK(FIND_gt_std_lower_bound)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK(FIND_gt_intrinsic)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(FIND_gt_isa, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(FIND_gt_isa, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(FIND_gt_isa, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK(FIND_gt_dispatch)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK(FIND_gt_stdsimd)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
 BENCHMARK_MAIN() ; 
 
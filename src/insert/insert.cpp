@@ -1,8 +1,11 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <unordered_map>
 #include <random>
+#include <cstdlib>
+#include <string>
 
 #ifdef XBENCHMARK_USE_XTENSOR
 #include <xtensor/xarray.hpp>
@@ -21,38 +24,59 @@
 #endif
 
 #include <utils/custom_arguments.hpp>
+#include <utils/key_streams.hpp>
+#include <insert/packed_memory_array.hpp>
+#include <insert/key_payload_store.hpp>
+#include <insert/interval_set.hpp>
+#include <utils/small_vector.hpp>
+#include <utils/counting_allocator.hpp>
 int min = 1 ;
 int max = 1000000 ;
 int threshold1 = 1024 ;
 int threshold2 = 8096 ;
 
+int key_range = 10000 ;        // intervalle de clés historique
+int large_key_range = 1 << 30 ; // pas de limite à 10000 clés distinctes
+int struct_scan_max = 1 << 17 ;  // taille max des parcours de data<S>
+
 
 const int MS = 4 ; // Min_size of arrays
 const int RM = 64 ; /// RangeMultiplier
 const int PS = 12 ; // pow size
 
 
+// taille approximative d'un noeud de std::map<int, int> (libstdc++ : 32 octets d'en-tête + la paire)
+const std::size_t map_node_bytes = 32 + sizeof(std::pair<const int, int>) ;
+
+
 // structure de données à insérer dans les cas _struct
 template <int S>
 struct data {
-	int value ; 
-	char padding[S] ; 
+	int value ;
+	char padding[S] ;
 };
 
 
-// Mesurer le temps de génération des nombres aléatoirtes
-// On s'attend à un cout de génération faible
-// Permet de vérifier qur nos mesures ont du sens lorsque le cout de génération est relativement faible
+// Flux de clés pré-généré hors de la boucle chronométrée, à partir des arguments (size, stream, range).
+// La graine est fixe : le même flux est rejoué à chaque run.
+std::vector<int> make_keys(benchmark::State& state) {
+	auto distribution = static_cast<key_distribution>(state.range(1)) ;
+	state.SetLabel(key_distribution_name(distribution)) ;
+	return generate_keys(distribution, state.range(0), state.range(2)) ;
+}
+
+
+// Mesurer le temps de lecture du flux de clés pré-généré
+// On s'attend à un cout négligeable : c'est la référence des autres benchmarks
+// (historiquement, le cout de génération des nombres aléatoires dans la boucle)
 void INSERT_timer(benchmark::State& state) {
         const int size = state.range(0);  // Vector size defined by benchmark range
-
-        std::random_device rd ;
-        std::mt19937 gen(rd()) ;
-        std::uniform_int_distribution<> distrib(0, 10000) ;
+        const std::vector<int> keys = make_keys(state) ;
 
         for (auto _ : state) {
-                for (int i = 0 ; i < size ; i++){		
-	        	int randomValue = distrib(gen) ;
+                for (int i = 0 ; i < size ; i++){
+	        	int randomValue = keys[i] ;
+	        	benchmark::DoNotOptimize(randomValue);
 		}
         }
         // report throughput
@@ -65,40 +89,38 @@ void INSERT_timer(benchmark::State& state) {
 // On s'attend à un cout d'insertion faible
 void INSERT_map(benchmark::State& state) {
 	const int size = state.range(0);  // Vector size defined by benchmark range
+	const std::vector<int> keys = make_keys(state) ;
 
-	std::random_device rd ; 
-	std::mt19937 gen(rd()) ; 
-	std::uniform_int_distribution<> distrib(0, 10000) ; 
-
+	std::size_t nodes = 0 ;
 	for (auto _ : state) {
 		std::map<int, int> map ;
 		for (int i = 0 ; i < size ; i++){
-			int randomValue = distrib(gen) ; 
-			map[randomValue] = randomValue ; 
+			int randomValue = keys[i] ;
+			map[randomValue] = randomValue ;
 		}
+		benchmark::DoNotOptimize(map);
+		nodes = map.size() ;
 	}
 	// report throughput
 	state.SetItemsProcessed(state.iterations() * size);
+	state.counters["bytes"] = nodes * map_node_bytes ;
 }
 
 // inserer des entiers aléatoires dans une std::unordered_map
 // On s'attend à un cout d'insertion encore plus faible
-// Utilisée à titre de comparaison pour mettre à défaut le mythe (ou non) du 
-// "Il faut utiliser une unoreded_map en AMR". 
+// Utilisée à titre de comparaison pour mettre à défaut le mythe (ou non) du
+// "Il faut utiliser une unoreded_map en AMR".
 void INSERT_unordered_map_unsorted(benchmark::State& state) {
         const int size = state.range(0);  // Vector size defined by benchmark range
-
-
-        std::random_device rd ;
-        std::mt19937 gen(rd()) ;
-        std::uniform_int_distribution<> distrib(0, 10000) ;
+        const std::vector<int> keys = make_keys(state) ;
 
         for (auto _ : state) {
 		std::unordered_map<int, int> map ;
 		for (int i = 0 ; i < size ; i++){
-	                int randomValue = distrib(gen) ;
+	                int randomValue = keys[i] ;
 	                map[randomValue] = randomValue ;
 		}
+		benchmark::DoNotOptimize(map);
 	}
         // report throughput
         state.SetItemsProcessed(state.iterations() * size);
@@ -106,52 +128,131 @@ void INSERT_unordered_map_unsorted(benchmark::State& state) {
 
 
 // inserer des entiers aléatoires dans une std::vector
-// Principe NAIF : on décalle (copie) à chaque insertion les éléments à droite. 
+// Principe NAIF : on décalle (copie) à chaque insertion les éléments à droite.
 // On s'attend à un cout d'insertion fort
 // Utilisée pour voir dans quelle mesure on peut remplacer la std::map via la vectorisation et l'alignement mémoire
 
 void INSERT_vector_insert(benchmark::State& state) {
         const int size = state.range(0);  // Vector size defined by benchmark range
+        const std::vector<int> keys = make_keys(state) ;
 
-
-        std::random_device rd ;
-        std::mt19937 gen(rd()) ;
-        std::uniform_int_distribution<> distrib(0, 10000) ;
-
+        std::size_t bytes = 0 ;
         for (auto _ : state) {
 		std::vector<int> vector ;
 		for (int i = 0 ; i < size ; i++){
-	                int randomValue = distrib(gen) ;
-			auto it = std::lower_bound(vector.begin(), vector.end() , randomValue) ; 
+	                int randomValue = keys[i] ;
+			auto it = std::lower_bound(vector.begin(), vector.end() , randomValue) ;
 			vector.insert(it, randomValue) ;
 		}
-		benchmark::DoNotOptimize(vector); 	
-
+		benchmark::DoNotOptimize(vector);
+		bytes = vector.capacity() * sizeof(int) ;
         }
         // report throughput
         state.SetItemsProcessed(state.iterations() * size);
+        state.counters["bytes"] = bytes ;
+}
+
+// inserer des entiers dans un packed memory array (tableau trié à trous).
+// Le pma se situe entre la std::map et le std::vector : insertion en O(log^2 n) amorti
+// et parcours presque contigu.
+void INSERT_pma(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+
+	for (auto _ : state) {
+		packed_memory_array<int, int> pma ;
+		for (int i = 0 ; i < size ; i++){
+			int key = keys[i] ;
+			pma.insert(key, key) ;
+		}
+		benchmark::DoNotOptimize(pma);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+// inserer des cellules dans un ensemble d'intervalles [start, end) avec fusion des voisins,
+// comme le fait le constructeur de maillage de samurai. Un intervalle n'est créé que pour
+// une cellule isolée : les flux groupés (clustered, amr_refinement) donnent peu d'intervalles.
+void INSERT_interval_set(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	std::size_t intervals = 0 ;
+	std::size_t bytes = 0 ;
+
+	for (auto _ : state) {
+		interval_set<int> set ;
+		for (int i = 0 ; i < size ; i++){
+			set.insert(keys[i]) ;
+		}
+		benchmark::DoNotOptimize(set);
+		intervals = set.interval_count() ;
+		bytes = set.memory() ;
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+	state.counters["intervals"] = intervals ;
+	state.counters["bytes"] = bytes ;
+}
+
+// suppression (déraffinement) de toutes les cellules du flux, dans l'ordre du flux.
+// Seule la suppression est chronométrée : le découpage d'intervalles y est fréquent.
+void INSERT_interval_set_erase(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	interval_set<int> reference ;
+	for (int i = 0 ; i < size ; i++){
+		reference.insert(keys[i]) ;
+	}
+
+	for (auto _ : state) {
+		state.PauseTiming() ;
+		interval_set<int> set = reference ;
+		state.ResumeTiming() ;
+		for (int i = 0 ; i < size ; i++){
+			set.erase(keys[i]) ;
+		}
+		benchmark::DoNotOptimize(set);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+	state.counters["intervals"] = reference.interval_count() ;
 }
 
-// à partir d'ici, on fait la même chose mais sur des struct, pour mieux representer notre cas d'usage sur samurai. 
+void INSERT_map_erase(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	std::map<int, int> reference ;
+	for (int i = 0 ; i < size ; i++){
+		reference[keys[i]] = keys[i] ;
+	}
+
+	for (auto _ : state) {
+		state.PauseTiming() ;
+		std::map<int, int> map = reference ;
+		state.ResumeTiming() ;
+		for (int i = 0 ; i < size ; i++){
+			map.erase(keys[i]) ;
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+// à partir d'ici, on fait la même chose mais sur des struct, pour mieux representer notre cas d'usage sur samurai.
 
 
 template <int S>
 void INSERT_map_struct(benchmark::State& state) {
         const int size = state.range(0);  // Vector size defined by benchmark range
-	using data = data<S> ; 
-
-
-        std::random_device rd ;
-        std::mt19937 gen(rd()) ;
-        std::uniform_int_distribution<> distrib(0, 10000) ;
+	using data = data<S> ;
+        const std::vector<int> keys = make_keys(state) ;
 
         for (auto _ : state) {
                 std::map<int, data> map ;
                 for (int i = 0 ; i < size ; i++){
-                        int randomValue = distrib(gen) ;
-			data myData {randomValue, 1, 2, 3} ; 
+                        int randomValue = keys[i] ;
+			data myData {randomValue, 1, 2, 3} ;
                         map[randomValue] = myData ;
                 }
+                benchmark::DoNotOptimize(map);
         }
         // report throughput
         state.SetItemsProcessed(state.iterations() * size);
@@ -160,22 +261,19 @@ void INSERT_map_struct(benchmark::State& state) {
 template <int S>
 void INSERT_vector_insert_struct(benchmark::State& state) {
         const int size = state.range(0);  // Vector size defined by benchmark range
-	using data = data<S> ; 
-
-        std::random_device rd ;
-        std::mt19937 gen(rd()) ;
-        std::uniform_int_distribution<> distrib(0, 10000) ;
+	using data = data<S> ;
+        const std::vector<int> keys = make_keys(state) ;
 
         for (auto _ : state) {
                 std::vector<data> vector ;
                 for (int i = 0 ; i < size ; i++){
-                        int randomValue = distrib(gen) ;
+                        int randomValue = keys[i] ;
                         auto it = std::lower_bound(vector.begin(), vector.end() , randomValue,
-					[](const data& d, int value) { 
+					[](const data& d, int value) {
 						return d.value < value;
 					});
 			data myData ;//{randomValue, 1, 2, 3} ;
-			myData.value = randomValue ; 
+			myData.value = randomValue ;
                         vector.insert(it, myData) ;
                 }
                 benchmark::DoNotOptimize(vector);
@@ -186,19 +284,394 @@ void INSERT_vector_insert_struct(benchmark::State& state) {
 }
 
 
+// Séparation clé / payload : le tableau trié ne contient que (clé, handle), les data<S> sont dans
+// un pool stable. Une insertion ne décale que 8 octets par élément au lieu de sizeof(data<S>).
+template <int S>
+void INSERT_key_payload_struct(benchmark::State& state) {
+	const int size = state.range(0);
+	using data = data<S> ;
+	const std::vector<int> keys = make_keys(state) ;
 
-// Power of two rule
-//
-BENCHMARK(INSERT_timer)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
-BENCHMARK(INSERT_map)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
-BENCHMARK(INSERT_unordered_map_unsorted)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
-BENCHMARK(INSERT_vector_insert)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+	for (auto _ : state) {
+		key_payload_store<int, data> store ;
+		for (int i = 0 ; i < size ; i++){
+			int randomValue = keys[i] ;
+			data myData ;
+			myData.value = randomValue ;
+			store.insert(randomValue, myData) ;
+		}
+		benchmark::DoNotOptimize(store);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+// même chose + passe de compaction finale (pool remis dans l'ordre des clés)
+template <int S>
+void INSERT_key_payload_struct_compact(benchmark::State& state) {
+	const int size = state.range(0);
+	using data = data<S> ;
+	const std::vector<int> keys = make_keys(state) ;
+
+	for (auto _ : state) {
+		key_payload_store<int, data> store ;
+		for (int i = 0 ; i < size ; i++){
+			int randomValue = keys[i] ;
+			data myData ;
+			myData.value = randomValue ;
+			store.insert(randomValue, myData) ;
+		}
+		store.compact() ;
+		benchmark::DoNotOptimize(store);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+// parcours dans l'ordre des clés, avec ou sans compaction préalable : mesure la perte de localité
+template <int S, bool Compact>
+void INSERT_key_payload_struct_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	using data = data<S> ;
+	const std::vector<int> keys = make_keys(state) ;
+
+	key_payload_store<int, data> store ;
+	for (int i = 0 ; i < size ; i++){
+		int randomValue = keys[i] ;
+		data myData ;
+		myData.value = randomValue ;
+		store.insert(randomValue, myData) ;
+	}
+	if (Compact) {
+		store.compact() ;
+	}
+	for (auto _ : state) {
+		long sum = 0 ;
+		store.for_each([&sum](int /*key*/, const data& d) { sum += d.value ; }) ;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * store.size());
+	state.SetBytesProcessed(state.iterations() * store.size() * (sizeof(int) + sizeof(std::uint32_t) + sizeof(data)));
+}
+
+
+// Parcours complet (dans l'ordre) après construction : on ne mesure que le parcours, qui somme les valeurs.
+// Octets traités : taille d'un élément stocké (clé + valeur) par élément parcouru.
+void INSERT_map_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	std::map<int, int> map ;
+	for (int i = 0 ; i < size ; i++){
+		map[keys[i]] = keys[i] ;
+	}
+	for (auto _ : state) {
+		long sum = 0 ;
+		for (const auto& [key, value] : map){
+			sum += value ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * map.size());
+	state.SetBytesProcessed(state.iterations() * map.size() * sizeof(std::pair<const int, int>));
+}
+
+// le vecteur est construit par tri + unique (même contenu que par insertions, sans le cout quadratique)
+void INSERT_vector_scan(benchmark::State& state) {
+	const std::vector<int> keys = make_keys(state) ;
+	std::vector<int> vector(keys) ;
+	std::sort(vector.begin(), vector.end()) ;
+	vector.erase(std::unique(vector.begin(), vector.end()), vector.end()) ;
+	for (auto _ : state) {
+		long sum = 0 ;
+		for (int value : vector){
+			sum += value ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * vector.size());
+	state.SetBytesProcessed(state.iterations() * vector.size() * sizeof(int));
+}
+
+// std::unordered_map n'est pas triée : un parcours dans l'ordre des clés demande de trier
+// des pointeurs vers les éléments. Le tri est chronométré avec le parcours.
+void INSERT_unordered_map_sort_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	std::unordered_map<int, int> map ;
+	for (int i = 0 ; i < size ; i++){
+		map[keys[i]] = keys[i] ;
+	}
+	std::vector<const std::pair<const int, int>*> sorted ;
+	for (auto _ : state) {
+		sorted.clear() ;
+		for (const auto& element : map){
+			sorted.push_back(&element) ;
+		}
+		std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) { return a->first < b->first ; }) ;
+		long sum = 0 ;
+		for (auto element : sorted){
+			sum += element->second ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * map.size());
+	state.SetBytesProcessed(state.iterations() * map.size() * sizeof(std::pair<const int, int>));
+}
+
+void INSERT_pma_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	packed_memory_array<int, int> pma ;
+	for (int i = 0 ; i < size ; i++){
+		pma.insert(keys[i], keys[i]) ;
+	}
+	for (auto _ : state) {
+		long sum = 0 ;
+		pma.for_each([&sum](int /*key*/, int value) { sum += value ; }) ;
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * pma.size());
+	state.SetBytesProcessed(state.iterations() * pma.size() * (sizeof(int) + sizeof(int)));
+}
+
+// mêmes parcours avec des data<S> : le cout du parcours suit la taille des éléments
+template <int S>
+void INSERT_map_struct_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	using data = data<S> ;
+	const std::vector<int> keys = make_keys(state) ;
+	std::map<int, data> map ;
+	for (int i = 0 ; i < size ; i++){
+		map[keys[i]].value = keys[i] ;
+	}
+	for (auto _ : state) {
+		long sum = 0 ;
+		for (const auto& [key, d] : map){
+			sum += d.value ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * map.size());
+	state.SetBytesProcessed(state.iterations() * map.size() * sizeof(std::pair<const int, data>));
+}
+
+template <int S>
+void INSERT_vector_struct_scan(benchmark::State& state) {
+	using data = data<S> ;
+	const std::vector<int> keys = make_keys(state) ;
+	std::vector<int> sorted_keys(keys) ;
+	std::sort(sorted_keys.begin(), sorted_keys.end()) ;
+	sorted_keys.erase(std::unique(sorted_keys.begin(), sorted_keys.end()), sorted_keys.end()) ;
+	std::vector<data> vector(sorted_keys.size()) ;
+	for (std::size_t i = 0 ; i < sorted_keys.size() ; i++){
+		vector[i].value = sorted_keys[i] ;
+	}
+	for (auto _ : state) {
+		long sum = 0 ;
+		for (const data& d : vector){
+			sum += d.value ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * vector.size());
+	state.SetBytesProcessed(state.iterations() * vector.size() * sizeof(data));
+}
+
+template <int S>
+void INSERT_unordered_map_struct_sort_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	using data = data<S> ;
+	const std::vector<int> keys = make_keys(state) ;
+	std::unordered_map<int, data> map ;
+	for (int i = 0 ; i < size ; i++){
+		map[keys[i]].value = keys[i] ;
+	}
+	std::vector<const std::pair<const int, data>*> sorted ;
+	for (auto _ : state) {
+		sorted.clear() ;
+		for (const auto& element : map){
+			sorted.push_back(&element) ;
+		}
+		std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) { return a->first < b->first ; }) ;
+		long sum = 0 ;
+		for (auto element : sorted){
+			sum += element->second.value ;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * map.size());
+	state.SetBytesProcessed(state.iterations() * map.size() * sizeof(std::pair<const int, data>));
+}
+
+
+// Petites listes par cellule (voisins, enfants) : size cellules, chacune reçoit de 2 à 8 éléments
+// par push_back. std::vector alloue pour chaque liste non vide (et à chaque doublement de capacité),
+// small_vector<int, N> n'alloue que pour les listes de plus de N éléments.
+// Les deux utilisent counting_allocator pour compter les allocations.
+using vector_list = std::vector<int, counting_allocator<int>> ;
+template <int N>
+using small_list = small_vector<int, N, counting_allocator<int>> ;
+
+// longueur de chaque liste, entre 2 et 8
+std::vector<int> list_lengths(int size) {
+	std::vector<int> lengths = generate_keys(key_distribution::uniform, size, 7, 42) ;
+	for (int& length : lengths) {
+		length += 2 ;
+	}
+	return lengths ;
+}
+
+template <typename List>
+void build_lists(std::vector<List>& lists, const std::vector<int>& lengths, const std::vector<int>& keys) {
+	const std::size_t size = lengths.size() ;
+	for (std::size_t i = 0 ; i < size ; i++) {
+		for (int j = 0 ; j < lengths[i] ; j++) {
+			lists[i].push_back(keys[(i + j) % size]) ;
+		}
+	}
+}
+
+// allocations par cellule, et allocations évitées par rapport à std::vector pour les mêmes listes
+template <typename List>
+void report_allocations(benchmark::State& state, const std::vector<int>& lengths, const std::vector<int>& keys) {
+	const std::size_t size = lengths.size() ;
+	allocation_counter::reset() ;
+	{
+		std::vector<vector_list> reference(size) ;
+		build_lists(reference, lengths, keys) ;
+	}
+	const std::size_t vector_allocations = allocation_counter::allocations ;
+	allocation_counter::reset() ;
+	{
+		std::vector<List> lists(size) ;
+		build_lists(lists, lengths, keys) ;
+	}
+	const std::size_t allocations = allocation_counter::allocations ;
+	state.counters["allocations"] = static_cast<double>(allocations) / std::max<std::size_t>(1, size) ;
+	state.counters["allocations_avoided"] = static_cast<double>(vector_allocations - allocations) / std::max<std::size_t>(1, size) ;
+}
 
-BENCHMARK_TEMPLATE(INSERT_map_struct, 12     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
-BENCHMARK_TEMPLATE(INSERT_vector_insert_struct, 12     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+template <typename List>
+void INSERT_cell_lists(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	const std::vector<int> lengths = list_lengths(size) ;
 
-BENCHMARK_TEMPLATE(INSERT_map_struct, 1020     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
-BENCHMARK_TEMPLATE(INSERT_vector_insert_struct, 1020     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+	for (auto _ : state) {
+		std::vector<List> lists(size) ;
+		build_lists(lists, lengths, keys) ;
+		benchmark::DoNotOptimize(lists.data());
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+	report_allocations<List>(state, lengths, keys) ;
+}
+
+// parcours de toutes les listes après construction
+template <typename List>
+void INSERT_cell_lists_scan(benchmark::State& state) {
+	const int size = state.range(0);
+	const std::vector<int> keys = make_keys(state) ;
+	const std::vector<int> lengths = list_lengths(size) ;
+	std::vector<List> lists(size) ;
+	build_lists(lists, lengths, keys) ;
+
+	for (auto _ : state) {
+		long sum = 0 ;
+		for (const List& list : lists){
+			for (int value : list){
+				sum += value ;
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+
+
+// Flux de clés utilisés pour comparer les containers (voir include/utils/key_streams.hpp)
+std::vector<key_distribution> all_streams = {
+	key_distribution::uniform,
+	key_distribution::sorted,
+	key_distribution::reverse,
+	key_distribution::zipf,
+	key_distribution::clustered,
+	key_distribution::amr_refinement
+};
+std::vector<key_distribution> uniform_stream = {key_distribution::uniform} ;
+
+// Balayage complet flux x intervalle, activé par XBENCHMARK_KEY_STREAMS=all : 6 flux x 2
+// intervalles sur des tailles réduites (puissances de 2 de 16 à stream_sweep_max),
+// sinon INSERT_vector_insert et les interval sets (quadratiques) ne terminent pas avec
+// 2^30 clés. Par défaut, seul le flux uniforme sur l'intervalle historique est enregistré.
+int stream_sweep_max = 1 << 14 ;
+
+bool stream_sweep_enabled() {
+	const char* env = std::getenv("XBENCHMARK_KEY_STREAMS") ;
+	return env != nullptr && std::string(env) == "all" ;
+}
+
+void InsertStreamArguments(benchmark::internal::Benchmark* b) {
+	if (stream_sweep_enabled()) {
+		KeyStreamArguments(b, all_streams, {key_range, large_key_range}, 16, stream_sweep_max, 16, 16) ;
+	} else {
+		KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2) ;
+	}
+}
+
+
+// Power of two rule
+// Arguments : (size, stream, range)
+BENCHMARK(INSERT_timer)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK(INSERT_map)->Apply(InsertStreamArguments);
+BENCHMARK(INSERT_unordered_map_unsorted)->Apply(InsertStreamArguments);
+BENCHMARK(INSERT_vector_insert)->Apply(InsertStreamArguments);
+BENCHMARK(INSERT_pma)->Apply(InsertStreamArguments);
+BENCHMARK(INSERT_interval_set)->Apply(InsertStreamArguments);
+BENCHMARK(INSERT_interval_set_erase)->Apply(InsertStreamArguments);
+BENCHMARK(INSERT_map_erase)->Apply(InsertStreamArguments);
+
+BENCHMARK_TEMPLATE(INSERT_map_struct, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_vector_insert_struct, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct_compact, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(INSERT_map_struct, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_vector_insert_struct, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct_compact, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(INSERT_map_struct, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_vector_insert_struct, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct_compact, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct_scan, 124, false     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_key_payload_struct_scan, 124, true     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+
+BENCHMARK(INSERT_map_scan)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK(INSERT_vector_scan)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK(INSERT_pma_scan)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK(INSERT_unordered_map_sort_scan)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, max, threshold1, threshold2);});;
+
+// data<1020> : 1 Go pour 1M éléments, on s'arrête à struct_scan_max
+BENCHMARK_TEMPLATE(INSERT_map_struct_scan, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_vector_struct_scan, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_unordered_map_struct_sort_scan, 12     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(INSERT_map_struct_scan, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_vector_struct_scan, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_unordered_map_struct_sort_scan, 124     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(INSERT_map_struct_scan, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_vector_struct_scan, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_unordered_map_struct_sort_scan, 1020     )->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {large_key_range}, min, struct_scan_max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(INSERT_cell_lists, vector_list)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists, small_list<4>)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists, small_list<8>)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists, small_list<16>)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists_scan, vector_list)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists_scan, small_list<4>)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists_scan, small_list<8>)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(INSERT_cell_lists_scan, small_list<16>)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, uniform_stream, {key_range}, min, max, threshold1, threshold2);});;
 
 
 BENCHMARK_MAIN();
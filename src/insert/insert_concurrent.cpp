@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <utils/custom_arguments.hpp>
+#include <utils/key_streams.hpp>
+#include <utils/spin_barrier.hpp>
+#include <insert/sharded_map.hpp>
+#include <insert/concurrent_hash_map.hpp>
+#include <insert/parallel_sorted_build.hpp>
+int min = 1 << 10 ;
+int max = 1 << 20 ;
+
+int key_range = 10000 ;         // beaucoup de clés communes : contention sur les mêmes clés
+int large_key_range = 1 << 30 ; // clés presque toutes distinctes
+
+int ncores = std::max(1u, std::thread::hardware_concurrency()) ;
+
+
+// Construction concurrente d'un container à partir d'un flux de clés pré-généré.
+// Chaque thread insère sa part du flux (size / threads clés) dans le MÊME container.
+// À chaque itération, le thread 0 vide le container hors chrono, entre deux barrières.
+// Le thread 0 mesure aussi le temps mur de la construction (jusqu'à la barrière de fin),
+// pour en déduire le débit et l'efficacité parallèle par rapport au run mono-thread.
+template <typename Container>
+struct shared_state {
+	spin_barrier barrier ;
+	std::vector<int> keys ;
+	Container container ;
+	double elapsed = 0.0 ;
+
+	template <typename... Args>
+	shared_state(benchmark::State& state, Args&&... args)
+		: barrier(state.threads()),
+		  keys(generate_keys(static_cast<key_distribution>(state.range(1)), state.range(0), state.range(2))),
+		  container(std::forward<Args>(args)...) {}
+};
+
+// débit mono-thread de référence, par (size, stream, range)
+using reference_rates = std::map<std::vector<long>, double> ;
+
+// appelée par le thread 0 seulement
+void report_scaling(benchmark::State& state, reference_rates& reference, double elapsed) {
+	double rate = static_cast<double>(state.iterations() * state.range(0)) / elapsed ;
+	std::vector<long> key = {static_cast<long>(state.range(0)), static_cast<long>(state.range(1)), static_cast<long>(state.range(2))} ;
+	if (state.threads() == 1) {
+		reference[key] = rate ;
+	}
+	state.counters["build_rate"] = rate ;
+	auto it = reference.find(key) ;
+	if (it != reference.end()) {
+		state.counters["efficiency"] = rate / (state.threads() * it->second) ;
+	}
+	state.SetLabel(key_distribution_name(static_cast<key_distribution>(state.range(1)))) ;
+}
+
+
+// std::map découpée en Shards intervalles de clés, un mutex par shard.
+// Shards = 1 : std::map derrière un verrou global (référence).
+template <int Shards>
+void INSERT_concurrent_sharded_map(benchmark::State& state) {
+	static shared_state<sharded_map<int>>* shared = nullptr ;
+	static reference_rates reference ;
+	const int size = state.range(0) ;
+	if (state.thread_index() == 0) {
+		shared = new shared_state<sharded_map<int>>(state, state.range(2), Shards) ;
+	}
+	const int first = state.thread_index() * size / state.threads() ;
+	const int last = (state.thread_index() + 1) * size / state.threads() ;
+	std::size_t contended = 0 ;
+
+	for (auto _ : state) {
+		state.PauseTiming() ;
+		shared->barrier.arrive_and_wait() ;
+		if (state.thread_index() == 0) {
+			shared->container.clear() ;
+		}
+		shared->barrier.arrive_and_wait() ;
+		state.ResumeTiming() ;
+
+		auto start = std::chrono::steady_clock::now() ;
+		for (int i = first ; i < last ; i++) {
+			int key = shared->keys[i] ;
+			shared->container.insert(key, key, contended) ;
+		}
+		shared->barrier.arrive_and_wait() ;
+		if (state.thread_index() == 0) {
+			shared->elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (last - first));
+	// fraction des insertions qui ont trouvé le verrou déjà pris
+	state.counters["contended"] = benchmark::Counter(static_cast<double>(contended) / (state.iterations() * std::max(1, last - first)), benchmark::Counter::kAvgThreads) ;
+	if (state.thread_index() == 0) {
+		report_scaling(state, reference, shared->elapsed) ;
+		delete shared ;
+	}
+}
+
+
+// Table de hachage à adressage ouvert sans verrou (CAS sur les clés)
+void INSERT_concurrent_hash_map(benchmark::State& state) {
+	static shared_state<concurrent_hash_map>* shared = nullptr ;
+	static reference_rates reference ;
+	const int size = state.range(0) ;
+	if (state.thread_index() == 0) {
+		shared = new shared_state<concurrent_hash_map>(state, size) ;
+	}
+	const int first = state.thread_index() * size / state.threads() ;
+	const int last = (state.thread_index() + 1) * size / state.threads() ;
+	std::size_t probes = 0 ;
+	std::size_t cas_failures = 0 ;
+
+	for (auto _ : state) {
+		state.PauseTiming() ;
+		shared->barrier.arrive_and_wait() ;
+		if (state.thread_index() == 0) {
+			shared->container.clear() ;
+		}
+		shared->barrier.arrive_and_wait() ;
+		state.ResumeTiming() ;
+
+		auto start = std::chrono::steady_clock::now() ;
+		for (int i = first ; i < last ; i++) {
+			int key = shared->keys[i] ;
+			shared->container.insert(key, key, probes, cas_failures) ;
+		}
+		shared->barrier.arrive_and_wait() ;
+		if (state.thread_index() == 0) {
+			shared->elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (last - first));
+	// sondages supplémentaires et CAS perdus par insertion
+	const double inserts = static_cast<double>(state.iterations() * std::max(1, last - first)) ;
+	state.counters["probes"] = benchmark::Counter(probes / inserts, benchmark::Counter::kAvgThreads) ;
+	state.counters["cas_failures"] = benchmark::Counter(cas_failures / inserts, benchmark::Counter::kAvgThreads) ;
+	if (state.thread_index() == 0) {
+		report_scaling(state, reference, shared->elapsed) ;
+		delete shared ;
+	}
+}
+
+
+// Construction locale à chaque thread (tri de sa part), puis fusion parallèle en un std::vector trié.
+// Aucune synchronisation pendant la construction, seulement deux barrières avant la fusion.
+void INSERT_concurrent_local_merge(benchmark::State& state) {
+	static shared_state<parallel_sorted_build>* shared = nullptr ;
+	static reference_rates reference ;
+	const int size = state.range(0) ;
+	if (state.thread_index() == 0) {
+		shared = new shared_state<parallel_sorted_build>(state, state.threads(), size) ;
+	}
+	const int first = state.thread_index() * size / state.threads() ;
+	const int last = (state.thread_index() + 1) * size / state.threads() ;
+
+	for (auto _ : state) {
+		state.PauseTiming() ;
+		shared->barrier.arrive_and_wait() ;
+		state.ResumeTiming() ;
+
+		auto start = std::chrono::steady_clock::now() ;
+		shared->container.run(state.thread_index(), shared->keys.data() + first, shared->keys.data() + last, shared->barrier) ;
+		shared->barrier.arrive_and_wait() ;
+		if (state.thread_index() == 0) {
+			shared->elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+			benchmark::DoNotOptimize(shared->container.result().data()) ;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (last - first));
+	if (state.thread_index() == 0) {
+		report_scaling(state, reference, shared->elapsed) ;
+		delete shared ;
+	}
+}
+
+
+std::vector<key_distribution> streams = {
+	key_distribution::uniform,
+	key_distribution::clustered,
+	key_distribution::amr_refinement
+};
+
+
+// Arguments : (size, stream, range), tailles en puissances de 2
+BENCHMARK_TEMPLATE(INSERT_concurrent_sharded_map, 1)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, streams, {key_range, large_key_range}, min, max, min, min);})->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK_TEMPLATE(INSERT_concurrent_sharded_map, 64)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, streams, {key_range, large_key_range}, min, max, min, min);})->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK(INSERT_concurrent_hash_map)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, streams, {key_range, large_key_range}, min, max, min, min);})->ThreadRange(1, ncores)->UseRealTime();
+BENCHMARK(INSERT_concurrent_local_merge)->Apply([](benchmark::internal::Benchmark* b) {KeyStreamArguments(b, streams, {key_range, large_key_range}, min, max, min, min);})->ThreadRange(1, ncores)->UseRealTime();
+
+
+BENCHMARK_MAIN();
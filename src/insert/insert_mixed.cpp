@@ -0,0 +1,247 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <insert/mixed_workload.hpp>
+int min = 1 << 10 ;
+int max = 1 << 20 ;
+
+const int mixed_ops = 1 << 14 ;  // opérations par itération
+const int sample_period = 8 ;    // une opération sur sample_period est chronométrée individuellement
+
+
+// Adaptateurs : même interface pour les trois containers.
+// erase renvoie la valeur supprimée pour pouvoir annuler l'opération.
+struct map_container {
+	std::map<int, int> map ;
+
+	void assign(const std::vector<int>& keys) {
+		map.clear() ;
+		for (int key : keys) {
+			map.emplace(key, key) ;
+		}
+	}
+	void insert(int key, int value) { map.emplace(key, value) ; }
+	int erase(int key) {
+		auto it = map.find(key) ;
+		int value = it->second ;
+		map.erase(it) ;
+		return value ;
+	}
+	int* find(int key) {
+		auto it = map.find(key) ;
+		return it == map.end() ? nullptr : &it->second ;
+	}
+	std::size_t size() const { return map.size() ; }
+};
+
+struct unordered_map_container {
+	std::unordered_map<int, int> map ;
+
+	void assign(const std::vector<int>& keys) {
+		map.clear() ;
+		map.reserve(keys.size()) ;
+		for (int key : keys) {
+			map.emplace(key, key) ;
+		}
+	}
+	void insert(int key, int value) { map.emplace(key, value) ; }
+	int erase(int key) {
+		auto it = map.find(key) ;
+		int value = it->second ;
+		map.erase(it) ;
+		return value ;
+	}
+	int* find(int key) {
+		auto it = map.find(key) ;
+		return it == map.end() ? nullptr : &it->second ;
+	}
+	std::size_t size() const { return map.size() ; }
+};
+
+// std::vector de paires (clé, valeur) trié par clé
+struct sorted_vector_container {
+	std::vector<std::pair<int, int>> vector ;
+
+	void assign(const std::vector<int>& keys) {
+		vector.clear() ;
+		for (int key : keys) {
+			vector.emplace_back(key, key) ;
+		}
+		std::sort(vector.begin(), vector.end()) ;
+	}
+	void insert(int key, int value) { vector.emplace(lower_bound(key), key, value) ; }
+	int erase(int key) {
+		auto it = lower_bound(key) ;
+		int value = it->second ;
+		vector.erase(it) ;
+		return value ;
+	}
+	int* find(int key) {
+		auto it = lower_bound(key) ;
+		return it == vector.end() || it->first != key ? nullptr : &it->second ;
+	}
+	std::size_t size() const { return vector.size() ; }
+
+	std::vector<std::pair<int, int>>::iterator lower_bound(int key) {
+		return std::lower_bound(vector.begin(), vector.end(), key,
+				[](const std::pair<int, int>& p, int value) { return p.first < value ; }) ;
+	}
+};
+
+
+// cout d'une mesure vide, retranché de chaque échantillon de latence
+double clock_overhead() {
+	double overhead = 1e9 ;
+	for (int i = 0 ; i < 1000 ; i++) {
+		auto start = std::chrono::steady_clock::now() ;
+		auto stop = std::chrono::steady_clock::now() ;
+		overhead = std::min(overhead, std::chrono::duration<double, std::nano>(stop - start).count()) ;
+	}
+	return overhead ;
+}
+
+template <typename Container>
+inline void apply(Container& container, const mixed_op& op, int& erased) {
+	switch (op.type) {
+		case operation::insert :
+			container.insert(op.key, op.key) ;
+			break ;
+		case operation::erase :
+			erased = container.erase(op.key) ;
+			break ;
+		case operation::lookup :
+			benchmark::DoNotOptimize(container.find(op.key)) ;
+			break ;
+		case operation::update :
+			*container.find(op.key) += 1 ;
+			break ;
+	}
+}
+
+// opération inverse, pour revenir à l'état initial hors chrono
+template <typename Container>
+inline void undo(Container& container, const mixed_op& op, int erased) {
+	switch (op.type) {
+		case operation::insert :
+			container.erase(op.key) ;
+			break ;
+		case operation::erase :
+			container.insert(op.key, erased) ;
+			break ;
+		case operation::lookup :
+			break ;
+		case operation::update :
+			*container.find(op.key) -= 1 ;
+			break ;
+	}
+}
+
+
+// Régime permanent : un container pré-rempli de `size` clés subit un mélange
+// d'insertions (raffinement), de suppressions (déraffinement), de recherches et de mises à jour.
+// Le flux d'opérations est généré une seule fois (include/insert/mixed_workload.hpp) et rejoué
+// à l'identique sur chaque container. Après chaque itération, les opérations sont annulées
+// dans l'ordre inverse hors chrono : chaque itération part du même état.
+template <typename Container>
+void INSERT_mixed(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const operation_mix mix {
+		static_cast<int>(state.range(1)), static_cast<int>(state.range(2)),
+		static_cast<int>(state.range(3)), static_cast<int>(state.range(4))} ;
+	const mixed_workload workload = generate_mixed_workload(size, mixed_ops, mix) ;
+	const std::vector<mixed_op>& ops = workload.ops ;
+
+	Container container ;
+	container.assign(workload.initial) ;
+	std::vector<int> erased(ops.size()) ;
+	latency_recorder latencies ;
+	const double overhead = clock_overhead() ;
+
+	// nombre d'opérations de chaque type dans le flux
+	std::vector<int64_t> type_count(operation_count, 0) ;
+	for (const mixed_op& op : ops) {
+		type_count[static_cast<std::size_t>(op.type)]++ ;
+	}
+
+	auto undo_all = [&] {
+		for (std::size_t i = ops.size() ; i-- > 0 ; ) {
+			undo(container, ops[i], erased[i]) ;
+		}
+	} ;
+
+	for (auto _ : state) {
+		// passe chronométrée, sans lecture d'horloge
+		for (std::size_t i = 0 ; i < ops.size() ; i++) {
+			apply(container, ops[i], erased[i]) ;
+		}
+		benchmark::ClobberMemory() ;
+
+		// hors chrono : annulation, puis même flux rejoué avec une opération sur sample_period
+		// chronométrée individuellement, puis nouvelle annulation
+		state.PauseTiming() ;
+		undo_all() ;
+		for (std::size_t i = 0 ; i < ops.size() ; i++) {
+			if (i % sample_period == 0) {
+				auto start = std::chrono::steady_clock::now() ;
+				apply(container, ops[i], erased[i]) ;
+				auto stop = std::chrono::steady_clock::now() ;
+				latencies.record(ops[i].type, std::max(0.0, std::chrono::duration<double, std::nano>(stop - start).count() - overhead)) ;
+			} else {
+				apply(container, ops[i], erased[i]) ;
+			}
+		}
+		undo_all() ;
+		state.ResumeTiming() ;
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size()) ;
+
+	// débit par type (opérations de ce type par seconde de la passe chronométrée) et
+	// latences p50 / p99 (ns) de la passe échantillonnée
+	for (std::size_t t = 0 ; t < operation_count ; t++) {
+		auto op = static_cast<operation>(t) ;
+		if (type_count[t] == 0) {
+			continue ;
+		}
+		std::string name = operation_name(op) ;
+		state.counters[name + "_rate"] = benchmark::Counter(static_cast<double>(type_count[t] * state.iterations()), benchmark::Counter::kIsRate) ;
+		if (latencies.count(op) == 0) {
+			continue ;
+		}
+		state.counters[name + "_p50"] = latencies.percentile(op, 0.50) ;
+		state.counters[name + "_p99"] = latencies.percentile(op, 0.99) ;
+	}
+}
+
+
+// Mélanges (insert, erase, lookup, update) en pourcentages
+std::vector<operation_mix> mixes = {
+	{10, 10, 70, 10},  // régime permanent : autant de raffinement que de déraffinement
+	{ 1,  1, 95,  3},  // surtout des recherches
+	{25, 25, 25, 25},  // forte adaptation du maillage
+	{40, 10, 40, 10},  // le maillage grossit
+};
+
+// Arguments : (size, insert, erase, lookup, update), tailles pré-remplies de min à max par facteur 8
+void MixedArguments(benchmark::internal::Benchmark* b) {
+	b->ArgNames({"size", "insert", "erase", "lookup", "update"}) ;
+	for (const operation_mix& mix : mixes) {
+		for (int size = min ; size <= max ; size *= 8) {
+			b->Args({size, mix.insert, mix.erase, mix.lookup, mix.update}) ;
+		}
+	}
+}
+
+
+BENCHMARK_TEMPLATE(INSERT_mixed, map_container)->Apply(MixedArguments);
+BENCHMARK_TEMPLATE(INSERT_mixed, unordered_map_container)->Apply(MixedArguments);
+BENCHMARK_TEMPLATE(INSERT_mixed, sorted_vector_container)->Apply(MixedArguments);
+
+
+BENCHMARK_MAIN();
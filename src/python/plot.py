@@ -17,6 +17,8 @@ METRICS = [
     "bytes_per_second",
     "items_per_second",
     "iterations",
+    "speedup",
+    "efficiency",
 ]
 TRANSFORMS = {"": lambda x: x, "inverse": lambda x: 1.0 / x}
 
@@ -83,6 +85,12 @@ def parse_args():
     parser.add_argument(
         "--output", type=str, default="", help="File in which to save the graph"
     )
+    parser.add_argument(
+        "--crossover",
+        action="store_true",
+        help="print, for each benchmark, the input size from which the metric stays >= 1 "
+        "(with -m speedup : the size below which OpenMP threading is a net loss)",
+    )
 
     args = parser.parse_args()
     if args.ylabel is None:
@@ -94,7 +102,14 @@ def parse_input_size(name):
     splits = name.split("/")
     if len(splits) == 1:
         return 1
-    return int(splits[1])
+    # named arguments : "size:1024"
+    return int(splits[1].split(":")[-1])
+
+
+def parse_label(name):
+    """Benchmark name without the input size, other arguments (threads, chunk...) kept"""
+    splits = name.split("/")
+    return "/".join(splits[:1] + splits[2:])
 
 
 def read_data(args):
@@ -114,7 +129,7 @@ def read_data(args):
             'Could not parse the benchmark data. Did you forget "--benchmark_format=[csv|json] when running the benchmark"?'
         )
         exit(1)
-    data["label"] = data["name"].apply(lambda x: x.split("/")[0])
+    data["label"] = data["name"].apply(parse_label)
     data["input"] = data["name"].apply(parse_input_size)
     data[args.metric] = data[args.metric].apply(TRANSFORMS[args.transform])
     return data
@@ -139,6 +154,20 @@ def plot_groups(label_groups, args):
         plt.show()
 
 
+def print_crossover(label_groups, args):
+    """Smallest input size from which the metric never goes below 1 again"""
+    for label, group in label_groups.items():
+        group = group.sort_index()
+        crossover = None
+        for size, value in zip(group["input"], group[args.metric]):
+            if value >= 1.0:
+                if crossover is None:
+                    crossover = size
+            else:
+                crossover = None
+        print("%s: %s" % (label, "never" if crossover is None else crossover))
+
+
 def main():
     """Entry point of the program"""
     args = parse_args()
@@ -157,6 +186,9 @@ def main():
     if args.relative_to is not None:
         for label in label_groups:
             label_groups[label][args.metric] /= baseline
+    if args.crossover:
+        print_crossover(label_groups, args)
+        return
     plot_groups(label_groups, args)
 
 
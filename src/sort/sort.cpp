@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <utils/custom_arguments.hpp>
+#include <sort/radix_sort.hpp>
+#if defined(XBENCHMARK_USE_IMMINTRIN) && defined(__AVX2__)
+#include <sort/simd_sort.hpp>
+#endif
+int min = 1 ;
+int max = 1000000 ;
+int threshold1 = 1024 ;
+int threshold2 = 8096 ;
+
+
+// clés 32 / 64 bits seules, ou paires (clé, valeur) de même taille
+using kv32 = key_value<std::int32_t, std::int32_t> ;
+using kv64 = key_value<std::int64_t, std::int64_t> ;
+
+template <typename T>
+bool less_key(const T& a, const T& b) { return key_of(a) < key_of(b) ; }
+
+
+// Clés uniformes sur tout l'intervalle du type, graine fixe. La valeur est l'indice d'origine.
+template <typename T>
+std::vector<T> random_elements(std::size_t n) {
+	using K = key_type<T> ;
+	std::mt19937_64 gen(1234) ;
+	std::vector<T> elements(n) ;
+	for (std::size_t i = 0 ; i < n ; i++) {
+		K key = static_cast<K>(gen()) ;
+		if constexpr (std::is_integral_v<T>) {
+			elements[i] = key ;
+		} else {
+			elements[i] = T{key, static_cast<decltype(T::value)>(i)} ;
+		}
+	}
+	return elements ;
+}
+
+
+// Chaque itération recopie l'entrée non triée dans le tableau à trier : SORT_copy mesure
+// ce coût seul, c'est la référence des autres benchmarks.
+template <typename T>
+void SORT_copy(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const std::vector<T> input = random_elements<T>(size) ;
+	std::vector<T> data(size) ;
+	for (auto _ : state) {
+		std::memcpy(data.data(), input.data(), size * sizeof(T)) ;
+		benchmark::DoNotOptimize(data.data()) ;
+		benchmark::ClobberMemory() ;
+	}
+	state.SetItemsProcessed(state.iterations() * size) ;
+}
+
+template <typename T>
+void SORT_std_sort(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const std::vector<T> input = random_elements<T>(size) ;
+	std::vector<T> data(size) ;
+	for (auto _ : state) {
+		std::memcpy(data.data(), input.data(), size * sizeof(T)) ;
+		std::sort(data.begin(), data.end(), less_key<T>) ;
+		benchmark::DoNotOptimize(data.data()) ;
+	}
+	state.SetItemsProcessed(state.iterations() * size) ;
+	state.counters["aux_bytes"] = 0 ;
+}
+
+// libstdc++ demande un tampon temporaire de (n + 1) / 2 éléments (fusion sur place sinon)
+template <typename T>
+void SORT_std_stable_sort(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const std::vector<T> input = random_elements<T>(size) ;
+	std::vector<T> data(size) ;
+	for (auto _ : state) {
+		std::memcpy(data.data(), input.data(), size * sizeof(T)) ;
+		std::stable_sort(data.begin(), data.end(), less_key<T>) ;
+		benchmark::DoNotOptimize(data.data()) ;
+	}
+	state.SetItemsProcessed(state.iterations() * size) ;
+	state.counters["aux_bytes"] = (size + 1) / 2 * sizeof(T) ;
+}
+
+// LSD radix, chiffres de Bits bits : 4 (8 bits) ou 3 (11 bits) passes pour des clés 32 bits
+template <int Bits, typename T>
+void SORT_lsd_radix(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const std::vector<T> input = random_elements<T>(size) ;
+	std::vector<T> data(size) ;
+	std::vector<T> buffer(size) ;
+	for (auto _ : state) {
+		std::memcpy(data.data(), input.data(), size * sizeof(T)) ;
+		lsd_radix_sort<Bits>(data.data(), size, buffer.data()) ;
+		benchmark::DoNotOptimize(data.data()) ;
+	}
+	state.SetItemsProcessed(state.iterations() * size) ;
+	state.counters["aux_bytes"] = lsd_radix_sort_memory<Bits, T>(size) ;
+}
+
+// MSD radix sur place (American flag sort), tri par insertion sous 32 éléments
+template <typename T>
+void SORT_msd_radix(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const std::vector<T> input = random_elements<T>(size) ;
+	std::vector<T> data(size) ;
+	for (auto _ : state) {
+		std::memcpy(data.data(), input.data(), size * sizeof(T)) ;
+		msd_radix_sort(data.data(), data.data() + size) ;
+		benchmark::DoNotOptimize(data.data()) ;
+	}
+	state.SetItemsProcessed(state.iterations() * size) ;
+	state.counters["aux_bytes"] = msd_radix_sort_memory<T>(size) ;
+}
+
+#if defined(XBENCHMARK_USE_IMMINTRIN) && defined(__AVX2__)
+// Réseau de tri AVX2 sur des blocs de 64 clés, puis fusion bitonique 8 x 8 en registres.
+// Clés 32 bits seulement : AVX2 n'a pas de min / max sur des entiers 64 bits.
+void SORT_simd(benchmark::State& state) {
+	const int size = state.range(0) ;
+	const std::vector<std::int32_t> input = random_elements<std::int32_t>(size) ;
+	std::vector<std::int32_t> data(size) ;
+	simd_sort sorter ;
+	for (auto _ : state) {
+		std::memcpy(data.data(), input.data(), size * sizeof(std::int32_t)) ;
+		sorter.sort(data.data(), size) ;
+		benchmark::DoNotOptimize(data.data()) ;
+	}
+	state.SetItemsProcessed(state.iterations() * size) ;
+	state.counters["aux_bytes"] = sorter.memory() ;
+}
+#endif
+
+
+BENCHMARK_TEMPLATE(SORT_copy, std::int32_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_sort, std::int32_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_stable_sort, std::int32_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 8, std::int32_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 11, std::int32_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_msd_radix, std::int32_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#if defined(XBENCHMARK_USE_IMMINTRIN) && defined(__AVX2__)
+BENCHMARK(SORT_simd)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+
+BENCHMARK_TEMPLATE(SORT_copy, std::int64_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_sort, std::int64_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_stable_sort, std::int64_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 8, std::int64_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 11, std::int64_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_msd_radix, std::int64_t)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(SORT_copy, kv32)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_sort, kv32)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_stable_sort, kv32)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 8, kv32)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 11, kv32)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_msd_radix, kv32)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+
+BENCHMARK_TEMPLATE(SORT_copy, kv64)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_sort, kv64)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_std_stable_sort, kv64)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 8, kv64)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_lsd_radix, 11, kv64)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(SORT_msd_radix, kv64)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,188 @@
+#include <utils/allocation_counter.hpp>
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <new>
+
+// Remplacement des fonctions d'allocation de la glibc : chaque fonction compte puis appelle
+// la fonction d'origine (__libc_*). operator new / delete appellent ces fonctions, chaque
+// allocation n'est donc comptée qu'une fois.
+extern "C" {
+void* __libc_malloc(std::size_t) ;
+void* __libc_calloc(std::size_t, std::size_t) ;
+void* __libc_realloc(void*, std::size_t) ;
+void* __libc_memalign(std::size_t, std::size_t) ;
+void __libc_free(void*) ;
+}
+
+namespace {
+
+std::atomic<int64_t> allocs {0} ;
+std::atomic<int64_t> frees {0} ;
+std::atomic<int64_t> bytes {0} ;
+std::atomic<int64_t> live_bytes {0} ;
+std::atomic<int64_t> peak_bytes {0} ;
+
+void count_alloc(void* p, std::size_t size) {
+	if (p == nullptr) {
+		return ;
+	}
+	allocs.fetch_add(1, std::memory_order_relaxed) ;
+	bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) ;
+	const int64_t usable = static_cast<int64_t>(malloc_usable_size(p)) ;
+	const int64_t live = live_bytes.fetch_add(usable, std::memory_order_relaxed) + usable ;
+	int64_t peak = peak_bytes.load(std::memory_order_relaxed) ;
+	while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void count_free(void* p) {
+	if (p == nullptr) {
+		return ;
+	}
+	frees.fetch_add(1, std::memory_order_relaxed) ;
+	live_bytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(p)), std::memory_order_relaxed) ;
+}
+
+void* counted_memalign(std::size_t alignment, std::size_t size) {
+	void* p = __libc_memalign(alignment, size) ;
+	count_alloc(p, size) ;
+	return p ;
+}
+
+void* new_or_throw(std::size_t size, std::size_t alignment = 0) {
+	void* p = alignment > alignof(std::max_align_t) ? counted_memalign(alignment, size) : malloc(size) ;
+	if (p == nullptr) {
+		throw std::bad_alloc() ;
+	}
+	return p ;
+}
+
+// Rapport pour chaque benchmark de chaque suite : Google Benchmark refait quelques itérations
+// entre Start() et Stop() et écrit allocs_per_iter et max_bytes_used dans la sortie JSON.
+// Start() / Stop() entourent toute la fonction du benchmark : les allocations faites avant la
+// boucle (tableaux d'entrée) sont comptées et divisées par le nombre d'itérations. Pour la
+// boucle seule : heap_counter et report_heap_allocations (include/utils/allocation_counter.hpp).
+class counting_memory_manager : public benchmark::MemoryManager {
+public:
+	void Start() override {
+		reset_allocation_peak() ;
+		m_start = allocation_snapshot() ;
+	}
+
+	void Stop(Result& result) override {
+		const allocation_stats stop = allocation_snapshot() ;
+		result.num_allocs = stop.allocs - m_start.allocs ;
+		result.max_bytes_used = stop.peak_bytes - m_start.live_bytes ;
+		result.total_allocated_bytes = stop.bytes - m_start.bytes ;
+		result.net_heap_growth = stop.live_bytes - m_start.live_bytes ;
+	}
+
+	// ancienne interface (Google Benchmark < 1.8)
+	void Stop(Result* result) { Stop(*result) ; }
+
+private:
+	allocation_stats m_start ;
+};
+
+counting_memory_manager memory_manager ;
+
+[[maybe_unused]] const bool registered = (benchmark::RegisterMemoryManager(&memory_manager), true) ;
+
+}
+
+allocation_stats allocation_snapshot() {
+	allocation_stats stats ;
+	stats.allocs = allocs.load(std::memory_order_relaxed) ;
+	stats.frees = frees.load(std::memory_order_relaxed) ;
+	stats.bytes = bytes.load(std::memory_order_relaxed) ;
+	stats.live_bytes = live_bytes.load(std::memory_order_relaxed) ;
+	stats.peak_bytes = peak_bytes.load(std::memory_order_relaxed) ;
+	return stats ;
+}
+
+void reset_allocation_peak() {
+	peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed) ;
+}
+
+
+extern "C" {
+
+void* malloc(std::size_t size) {
+	void* p = __libc_malloc(size) ;
+	count_alloc(p, size) ;
+	return p ;
+}
+
+void* calloc(std::size_t count, std::size_t size) {
+	void* p = __libc_calloc(count, size) ;
+	count_alloc(p, count * size) ;
+	return p ;
+}
+
+// compté comme une libération suivie d'une allocation
+void* realloc(void* old, std::size_t size) {
+	const std::size_t old_usable = old != nullptr ? malloc_usable_size(old) : 0 ;
+	void* p = __libc_realloc(old, size) ;
+	if (p == nullptr && size != 0) {
+		return p ;  // échec : old est toujours alloué
+	}
+	if (old != nullptr) {
+		frees.fetch_add(1, std::memory_order_relaxed) ;
+		live_bytes.fetch_sub(static_cast<int64_t>(old_usable), std::memory_order_relaxed) ;
+	}
+	count_alloc(p, size) ;
+	return p ;
+}
+
+void free(void* p) {
+	count_free(p) ;
+	__libc_free(p) ;
+}
+
+void* memalign(std::size_t alignment, std::size_t size) {
+	return counted_memalign(alignment, size) ;
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) {
+	return counted_memalign(alignment, size) ;
+}
+
+int posix_memalign(void** p, std::size_t alignment, std::size_t size) {
+	if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+		return EINVAL ;
+	}
+	void* data = counted_memalign(alignment, size) ;
+	if (data == nullptr) {
+		return ENOMEM ;
+	}
+	*p = data ;
+	return 0 ;
+}
+
+}
+
+
+void* operator new(std::size_t size) { return new_or_throw(size) ; }
+void* operator new[](std::size_t size) { return new_or_throw(size) ; }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return malloc(size) ; }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return malloc(size) ; }
+void* operator new(std::size_t size, std::align_val_t alignment) { return new_or_throw(size, static_cast<std::size_t>(alignment)) ; }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return new_or_throw(size, static_cast<std::size_t>(alignment)) ; }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_memalign(static_cast<std::size_t>(alignment), size) ; }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_memalign(static_cast<std::size_t>(alignment), size) ; }
+
+void operator delete(void* p) noexcept { free(p) ; }
+void operator delete[](void* p) noexcept { free(p) ; }
+void operator delete(void* p, std::size_t) noexcept { free(p) ; }
+void operator delete[](void* p, std::size_t) noexcept { free(p) ; }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p) ; }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p) ; }
+void operator delete(void* p, std::align_val_t) noexcept { free(p) ; }
+void operator delete[](void* p, std::align_val_t) noexcept { free(p) ; }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { free(p) ; }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { free(p) ; }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { free(p) ; }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { free(p) ; }
@@ -1,27 +1,38 @@
 #include <utils/custom_arguments.hpp>
 
-void CustomArguments(
-		benchmark::internal::Benchmark* b,
+std::vector<int> CustomSizes(
 		int start ,
 		int end,
 		int threshold1,
 		int threshold2
 		) {
+  std::vector<int> sizes ;
 
   // Phase linéaire (incréments de 1)
   for (int i = start; i < threshold1 && i <= end; ++i) {
-    b->Arg(i);
+    sizes.push_back(i);
   }
 
   // Phase linéaire (incréments de 4)
   for (int i = threshold1; i <= threshold2 && i <= end; i+=8) {
-    b->Arg(i);
+    sizes.push_back(i);
   }
 
   // Phase exponentielle (puissances de 2)
   for (int i = threshold2 * 2; i <= end; i *= 2) {
-    b->Arg(i);
+    sizes.push_back(i);
   }
+  return sizes ;
 }
 
-
+void CustomArguments(
+		benchmark::internal::Benchmark* b,
+		int start ,
+		int end,
+		int threshold1,
+		int threshold2
+		) {
+  for (int size : CustomSizes(start, end, threshold1, threshold2)) {
+    b->Arg(size);
+  }
+}
@@ -0,0 +1,164 @@
+#include <utils/key_streams.hpp>
+#include <utils/custom_arguments.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+
+namespace {
+
+// Zipf par rejection-inversion (Hörmann & Derflinger, 1996) : O(1) par tirage et pas de table,
+// ce qui permet des intervalles de clés très grands.
+class zipf_sampler {
+public:
+	zipf_sampler(std::int64_t n, double exponent) : m_n(n), m_s(exponent) {
+		m_h_integral_x1 = h_integral(1.5) - 1.0 ;
+		m_h_integral_n = h_integral(static_cast<double>(n) + 0.5) ;
+		m_s_div = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0)) ;
+	}
+
+	// rang dans [1, n]
+	template <typename G>
+	std::int64_t operator()(G& gen) {
+		std::uniform_real_distribution<double> distrib(0.0, 1.0) ;
+		while (true) {
+			double u = m_h_integral_n + distrib(gen) * (m_h_integral_x1 - m_h_integral_n) ;
+			double x = h_integral_inverse(u) ;
+			std::int64_t k = static_cast<std::int64_t>(x + 0.5) ;
+			k = std::clamp<std::int64_t>(k, 1, m_n) ;
+			if (k - x <= m_s_div || u >= h_integral(k + 0.5) - h(static_cast<double>(k))) {
+				return k ;
+			}
+		}
+	}
+
+private:
+	std::int64_t m_n ;
+	double m_s ;
+	double m_h_integral_x1 ;
+	double m_h_integral_n ;
+	double m_s_div ;
+
+	double h(double x) const { return std::exp(-m_s * std::log(x)) ; }
+
+	double h_integral(double x) const {
+		double log_x = std::log(x) ;
+		return helper2((1.0 - m_s) * log_x) * log_x ;
+	}
+
+	double h_integral_inverse(double x) const {
+		double t = std::max(x * (1.0 - m_s), -1.0) ;
+		return std::exp(helper1(t) * x) ;
+	}
+
+	// log1p(x)/x et expm1(x)/x, stables autour de 0 (cas exposant = 1)
+	static double helper1(double x) {
+		return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x)) ;
+	}
+	static double helper2(double x) {
+		return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x)) ;
+	}
+};
+
+} // namespace
+
+
+const char* key_distribution_name(key_distribution distribution) {
+	switch (distribution) {
+		case key_distribution::uniform :        return "uniform" ;
+		case key_distribution::sorted :         return "sorted" ;
+		case key_distribution::reverse :        return "reverse" ;
+		case key_distribution::zipf :           return "zipf" ;
+		case key_distribution::clustered :      return "clustered" ;
+		case key_distribution::amr_refinement : return "amr_refinement" ;
+	}
+	return "unknown" ;
+}
+
+
+std::vector<int> generate_keys(
+		key_distribution distribution,
+		std::size_t count,
+		int key_range,
+		std::uint32_t seed
+		) {
+	std::mt19937 gen(seed) ;
+	std::uniform_int_distribution<int> distrib(0, key_range - 1) ;
+	std::vector<int> keys ;
+	keys.reserve(count) ;
+
+	switch (distribution) {
+		case key_distribution::uniform :
+		case key_distribution::sorted :
+		case key_distribution::reverse :
+			for (std::size_t i = 0 ; i < count ; i++) {
+				keys.push_back(distrib(gen)) ;
+			}
+			if (distribution == key_distribution::sorted) {
+				std::sort(keys.begin(), keys.end()) ;
+			} else if (distribution == key_distribution::reverse) {
+				std::sort(keys.begin(), keys.end(), std::greater<int>()) ;
+			}
+			break ;
+
+		case key_distribution::zipf : {
+			zipf_sampler zipf(key_range, 1.0) ;
+			for (std::size_t i = 0 ; i < count ; i++) {
+				keys.push_back(static_cast<int>(zipf(gen) - 1)) ;
+			}
+			break ;
+		}
+
+		case key_distribution::clustered : {
+			const int burst = std::min(64, key_range) ;
+			std::uniform_int_distribution<int> base_distrib(0, key_range - burst) ;
+			int base = 0 ;
+			for (std::size_t i = 0 ; i < count ; i++) {
+				if (i % burst == 0) {
+					base = base_distrib(gen) ;
+				}
+				keys.push_back(base + static_cast<int>(i % burst)) ;
+			}
+			break ;
+		}
+
+		case key_distribution::amr_refinement : {
+			// a region of `width` coarse cells is refined `depth` times : we emit the
+			// width * 2^depth children in order, then jump to another region
+			std::uniform_int_distribution<int> depth_distrib(1, 3) ;
+			std::uniform_int_distribution<int> width_distrib(1, 8) ;
+			while (keys.size() < count) {
+				int depth = depth_distrib(gen) ;
+				int burst = std::min(width_distrib(gen) << depth, key_range) ;
+				std::uniform_int_distribution<int> first_distrib(0, (key_range - burst) >> depth) ;
+				int first = first_distrib(gen) << depth ;
+				for (int j = 0 ; j < burst && keys.size() < count ; j++) {
+					keys.push_back(first + j) ;
+				}
+			}
+			break ;
+		}
+	}
+	return keys ;
+}
+
+
+void KeyStreamArguments(
+		benchmark::internal::Benchmark* b,
+		const std::vector<key_distribution>& distributions,
+		const std::vector<int>& key_ranges,
+		int start,
+		int end,
+		int threshold1,
+		int threshold2
+		) {
+	b->ArgNames({"size", "stream", "range"}) ;
+	for (int key_range : key_ranges) {
+		for (key_distribution distribution : distributions) {
+			for (int size : CustomSizes(start, end, threshold1, threshold2)) {
+				b->Args({size, static_cast<int>(distribution), key_range}) ;
+			}
+		}
+	}
+}
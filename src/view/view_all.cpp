@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #ifdef XBENCHMARK_USE_XTENSOR
 #include <xtensor/xarray.hpp>
@@ -11,13 +14,25 @@
 #include <xtensor/xstrided_view.hpp>
 #include <xtensor/xio.hpp>
 #include <xtensor/xmasked_view.hpp>
+#include <xtensor/xadapt.hpp>
 #endif
 
 #ifdef XBENCHMARK_USE_IMMINTRIN
 #include <immintrin.h>
 #endif
 
+#ifdef XBENCHMARK_USE_STDSIMD
+#include <blas1/stdsimd_kernels.hpp>
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+#include <utils/kokkos_benchmark.hpp>
+#endif
+
+#include <blas1/isa_kernels.hpp>
 #include <utils/custom_arguments.hpp>
+#include <allocation/huge_pages.hpp>
+#include <utils/numa_benchmark.hpp>
 int min = 1 ;
 int max = 1000000 ;
 int threshold1 = 1024 ;
@@ -29,6 +44,8 @@ const int MS = 16 ; // Min_size of arrays
 const int RM = 128 ; /// RangeMultiplier
 const int PS = 21 ; // pow size
 
+int ncores = std::max(1u, std::thread::hardware_concurrency()) ;
+
 template <typename T>
 void VIEW_all_raw(benchmark::State& state) {
 	const int vector_size = state.range(0);  // Vector size defined by benchmark range
@@ -61,10 +78,10 @@ void VIEW_all_aligned(benchmark::State& state) {
 
 	constexpr std::size_t alignment = 64;
 
-	// Allocate aligned memory using std::aligned_alloc
-	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+	// Allocate aligned memory (default_page_alloc : 4 KB or huge pages, see XBENCHMARK_PAGES)
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
 	// Initialize arrays
 	for (int i = 0; i < vector_size; ++i) {
 		vec1[i] = 1;
@@ -79,9 +96,9 @@ void VIEW_all_aligned(benchmark::State& state) {
 		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
 	}
 	// Free aligned memory
-	std::free(vec1);
-	std::free(vec2);
-	std::free(result);
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
@@ -91,11 +108,11 @@ void VIEW_all_aligned_masked(benchmark::State& state) {
 
 	constexpr std::size_t alignment = 64;
 
-	// Allocate aligned memory using std::aligned_alloc
-	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	bool* mask = static_cast<bool*>(std::aligned_alloc(alignment, vector_size * sizeof(bool))) ; 
+	// Allocate aligned memory (default_page_alloc : 4 KB or huge pages, see XBENCHMARK_PAGES)
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
+	bool* mask = default_page_alloc<bool>(vector_size, alignment) ; 
 	// Initialize arrays
 	for (int i = 0; i < vector_size; ++i) {
 		vec1[i] = 1;
@@ -114,12 +131,247 @@ void VIEW_all_aligned_masked(benchmark::State& state) {
 		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
 	}
 	// Free aligned memory
-	std::free(vec1);
-	std::free(vec2);
-	std::free(result);
-	std::free(mask);
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	default_page_free(mask);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// Masked loop of VIEW_all_aligned_masked compiled once per ISA level
+// (include/blas1/isa_kernels.hpp) : blend / masked stores depend on the instruction set, the
+// avx512 version can use mask registers
+template <typename T, isa_level L>
+void VIEW_all_isa_masked(benchmark::State& state) {
+	if (const char* reason = isa_unavailable(L)) {
+		state.SkipWithError(reason);
+		return;
+	}
+	const int vector_size = state.range(0);
+	T* vec1 = default_page_alloc<T>(vector_size);
+	T* vec2 = default_page_alloc<T>(vector_size);
+	T* result = default_page_alloc<T>(vector_size);
+	bool* mask = default_page_alloc<bool>(vector_size) ; 
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0 ;
+		mask[i] = 1 ; 
+	}
+	for (auto _ : state) {
+		isa_kernels<L>::masked_add(vec1, vec2, mask, result, vector_size) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	default_page_free(mask);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+
+// Same loop, version chosen at run time (best level of the CPU, capped by XBENCHMARK_ISA)
+template <typename T>
+void VIEW_all_dispatch_masked(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	T* vec1 = default_page_alloc<T>(vector_size);
+	T* vec2 = default_page_alloc<T>(vector_size);
+	T* result = default_page_alloc<T>(vector_size);
+	bool* mask = default_page_alloc<bool>(vector_size) ; 
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0 ;
+		mask[i] = 1 ; 
+	}
+	// resolved once, as an ifunc resolver would do
+	void (*masked_add)(const T*, const T*, const bool*, T*, std::size_t) = dispatch_isa(active_isa(), [](auto level) {
+		return &isa_kernels<decltype(level)::value>::template masked_add<T> ;
+	}) ;
+	for (auto _ : state) {
+		masked_add(vec1, vec2, mask, result, vector_size) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	default_page_free(mask);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(isa_name(active_isa()));
+}
+
+#ifdef XBENCHMARK_USE_STDSIMD
+// Same masked kernel with std::experimental::simd (include/blas1/stdsimd_kernels.hpp) : the bool
+// mask is loaded as a simd_mask and the sum is assigned through where(mask, result)
+template <typename T>
+void VIEW_all_stdsimd_masked(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	T* vec1 = default_page_alloc<T>(vector_size);
+	T* vec2 = default_page_alloc<T>(vector_size);
+	T* result = default_page_alloc<T>(vector_size);
+	bool* mask = default_page_alloc<bool>(vector_size) ; 
+	for (int i = 0; i < vector_size; ++i) {
+		vec1[i] = 1;
+		vec2[i] = 2;
+		result[i] = 0 ;
+		mask[i] = 1 ; 
+	}
+	for (auto _ : state) {
+		stdsimd_masked_add(vec1, vec2, mask, result, vector_size) ;
+		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
+	}
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	default_page_free(mask);
+	state.SetItemsProcessed(state.iterations() * vector_size);
+}
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+// Kokkos::View + parallel_for on the execution space Space (include/utils/kokkos_benchmark.hpp),
+// same kernel as VIEW_all_aligned
+template <typename T, typename Space>
+void VIEW_all_kokkos(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::View<T*, Space> result("result", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		Kokkos::parallel_for("VIEW_all_kokkos", Kokkos::RangePolicy<Space>(0, vector_size), KOKKOS_LAMBDA(const int i) {
+			result(i) = vec1(i) + vec2(i) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(kokkos_label<Space>());
+}
+
+// Kokkos::subview(v, Kokkos::ALL) built inside the timed loop, as VIEW_all_xtensor builds
+// xt::view(v, xt::all()) : the subview type has a runtime stride (LayoutStride or the layout of
+// v, depending on what Kokkos can prove)
+template <typename T, typename Space>
+void VIEW_all_kokkos_subview(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::View<T*, Space> result("result", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		auto view1 = Kokkos::subview(vec1, Kokkos::ALL) ;
+		auto view2 = Kokkos::subview(vec2, Kokkos::ALL) ;
+		Kokkos::parallel_for("VIEW_all_kokkos_subview", Kokkos::RangePolicy<Space>(0, vector_size), KOKKOS_LAMBDA(const int i) {
+			result(i) = view1(i) + view2(i) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(kokkos_label<Space>());
+}
+
+// subview on the range [first, first + length), as xt::range(first, first + length, 1) in
+// VIEW_all_xtensor_range (whole array) and VIEW_all_xtensor_range_only_one (last element) :
+// Length = 0 means the whole array, otherwise the last Length elements
+template <typename T, typename Space, int Length>
+void VIEW_all_kokkos_subview_range(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	const std::size_t length = Length == 0 ? vector_size : std::min(Length, vector_size) ;
+	const std::size_t first = vector_size - length ;
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::View<T*, Space> result("result", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	const std::pair<std::size_t, std::size_t> range(first, first + length) ;
+	for (auto _ : state) {
+		auto view1 = Kokkos::subview(vec1, range) ;
+		auto view2 = Kokkos::subview(vec2, range) ;
+		auto view_result = Kokkos::subview(result, range) ;
+		Kokkos::parallel_for("VIEW_all_kokkos_subview_range", Kokkos::RangePolicy<Space>(0, length), KOKKOS_LAMBDA(const int i) {
+			view_result(i) = view1(i) + view2(i) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * length);
+	state.SetLabel(kokkos_label<Space>());
+}
+
+// masked kernel of VIEW_all_aligned_masked on Views, the mask is a View<bool*>
+template <typename T, typename Space>
+void VIEW_all_kokkos_masked(benchmark::State& state) {
+	const int vector_size = state.range(0);
+	Kokkos::View<T*, Space> vec1("vec1", vector_size);
+	Kokkos::View<T*, Space> vec2("vec2", vector_size);
+	Kokkos::View<T*, Space> result("result", vector_size);
+	Kokkos::View<bool*, Space> mask("mask", vector_size);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	Kokkos::deep_copy(mask, true);
+	for (auto _ : state) {
+		Kokkos::parallel_for("VIEW_all_kokkos_masked", Kokkos::RangePolicy<Space>(0, vector_size), KOKKOS_LAMBDA(const int i) {
+			result(i) = mask(i) ? vec1(i) + vec2(i) : result(i) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
 	state.SetItemsProcessed(state.iterations() * vector_size);
+	state.SetLabel(kokkos_label<Space>());
+}
+
+// Fields of Components values per cell : 2D Views (cells, components). LayoutRight stores the
+// components of a cell next to each other (array of structures), LayoutLeft stores each
+// component contiguously (structure of arrays). One work item per cell, loop over the
+// components inside : contiguous with LayoutRight, stride = cells with LayoutLeft.
+template <typename T, typename Layout, typename Space, int Components>
+void VIEW_all_kokkos_field(benchmark::State& state) {
+	const int cells = state.range(0);
+	Kokkos::View<T**, Layout, Space> vec1("vec1", cells, Components);
+	Kokkos::View<T**, Layout, Space> vec2("vec2", cells, Components);
+	Kokkos::View<T**, Layout, Space> result("result", cells, Components);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		Kokkos::parallel_for("VIEW_all_kokkos_field", Kokkos::RangePolicy<Space>(0, cells), KOKKOS_LAMBDA(const int i) {
+			for (int c = 0 ; c < Components ; c++) {
+				result(i, c) = vec1(i, c) + vec2(i, c) ;
+			}
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * cells * Components);
+	state.SetLabel(kokkos_label<Space>());
+}
+
+// One component of the fields : subview(v, Kokkos::ALL, 0), contiguous with LayoutLeft,
+// stride = Components with LayoutRight
+template <typename T, typename Layout, typename Space, int Components>
+void VIEW_all_kokkos_component(benchmark::State& state) {
+	const int cells = state.range(0);
+	Kokkos::View<T**, Layout, Space> vec1("vec1", cells, Components);
+	Kokkos::View<T**, Layout, Space> vec2("vec2", cells, Components);
+	Kokkos::View<T**, Layout, Space> result("result", cells, Components);
+	Kokkos::deep_copy(vec1, T(1));
+	Kokkos::deep_copy(vec2, T(2));
+	for (auto _ : state) {
+		auto view1 = Kokkos::subview(vec1, Kokkos::ALL, 0) ;
+		auto view2 = Kokkos::subview(vec2, Kokkos::ALL, 0) ;
+		auto view_result = Kokkos::subview(result, Kokkos::ALL, 0) ;
+		Kokkos::parallel_for("VIEW_all_kokkos_component", Kokkos::RangePolicy<Space>(0, cells), KOKKOS_LAMBDA(const int i) {
+			view_result(i) = view1(i) + view2(i) ;
+		});
+		kokkos_fence<Space>() ;
+		benchmark::DoNotOptimize(result.data()); // Prevent compiler optimizations
+	}
+	state.SetItemsProcessed(state.iterations() * cells);
+	state.SetLabel(kokkos_label<Space>());
 }
+#endif
 
 #ifdef XBENCHMARK_USE_IMMINTRIN
 // TODO : optimize this kernel : we want this to compile into avx mask instructions
@@ -341,12 +593,65 @@ void VIEW_all_xtensor_raw_masked(benchmark::State& state) {
 
 
 
+// Multi-threaded versions : arrays shared by all the threads, each thread computes the view
+// of its own chunk. range(1) selects the numa_policy of the pages, range(2) the thread_placement
+// (see include/allocation/numa.hpp).
+template <typename T>
+void VIEW_all_numa(benchmark::State& state) {
+	static std::atomic<numa_shared<T>*> shared {nullptr} ;
+	numa_thread<T> thread(state, shared, state.range(0), {1, 2, 0}) ;
+	const T* vec1 = thread.array(0) + thread.first() ;
+	const T* vec2 = thread.array(1) + thread.first() ;
+	T* result = thread.array(2) + thread.first() ;
+	const std::size_t chunk_size = thread.last() - thread.first() ;
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < chunk_size; ++i) {
+			result[i] = vec1[i] + vec2[i];
+		}
+		benchmark::DoNotOptimize(result);
+	}
+	thread.report(state, 3 * sizeof(T)) ;
+}
+
+#ifdef XBENCHMARK_USE_XTENSOR
+template <typename T>
+void VIEW_all_xtensor_numa(benchmark::State& state) {
+	static std::atomic<numa_shared<T>*> shared {nullptr} ;
+	const std::size_t vector_size = state.range(0);
+	numa_thread<T> thread(state, shared, vector_size, {1, 2, 0}) ;
+	const std::array<std::size_t, 1> shape = {vector_size} ;
+	auto vec1 = xt::adapt(thread.array(0), vector_size, xt::no_ownership(), shape) ;
+	auto vec2 = xt::adapt(thread.array(1), vector_size, xt::no_ownership(), shape) ;
+	auto result = xt::adapt(thread.array(2), vector_size, xt::no_ownership(), shape) ;
+	for (auto _ : state) {
+		auto view1 = xt::view(vec1, xt::range(thread.first(), thread.last())) ;
+		auto view2 = xt::view(vec2, xt::range(thread.first(), thread.last())) ;
+		auto view_result = xt::view(result, xt::range(thread.first(), thread.last())) ;
+		xt::noalias(view_result) = view1 + view2;
+
+		benchmark::DoNotOptimize(result.data());
+	}
+	thread.report(state, 3 * sizeof(T)) ;
+}
+#endif
+
+
+
 
 // Power of two rule
 //
 BENCHMARK_TEMPLATE(VIEW_all_raw, float     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(VIEW_all_aligned, float     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(VIEW_all_aligned_masked, float     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(VIEW_all_isa_masked, float, isa_level::sse42)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(VIEW_all_isa_masked, float, isa_level::avx2)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(VIEW_all_isa_masked, float, isa_level::avx512)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(VIEW_all_dispatch_masked, float     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#ifdef XBENCHMARK_USE_STDSIMD
+BENCHMARK_TEMPLATE(VIEW_all_stdsimd_masked, float     )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+#endif
+// 4 MB to 128 MB per array, from 1 thread to every core
+BENCHMARK_TEMPLATE(VIEW_all_numa, float)->Apply([](benchmark::internal::Benchmark* b) {NumaArguments(b, {1 << 20, 1 << 23, 1 << 25});})->ThreadRange(1, ncores)->UseRealTime();
 #ifdef XBENCHMARK_USE_IMMINTRIN
 #endif
 #ifdef XBENCHMARK_USE_XTENSOR
@@ -359,10 +664,42 @@ BENCHMARK_TEMPLATE(VIEW_all_xtensor_range_only_one,float    )->Apply([](benchmar
 BENCHMARK_TEMPLATE(VIEW_all_xtensor_masked, float      )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(VIEW_all_xtensor_masked_2, float      )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
 BENCHMARK_TEMPLATE(VIEW_all_xtensor_raw_masked, float      )->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);});;
+BENCHMARK_TEMPLATE(VIEW_all_xtensor_numa, float)->Apply([](benchmark::internal::Benchmark* b) {NumaArguments(b, {1 << 20, 1 << 23, 1 << 25});})->ThreadRange(1, ncores)->UseRealTime();
 #endif
 
 
+#ifdef XBENCHMARK_USE_KOKKOS
+#ifdef KOKKOS_ENABLE_SERIAL
+BENCHMARK_TEMPLATE(VIEW_all_kokkos, float, Kokkos::Serial)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_subview, float, Kokkos::Serial)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_subview_range, float, Kokkos::Serial, 0)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_subview_range, float, Kokkos::Serial, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_masked, float, Kokkos::Serial)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+// 4 components per cell, range(0) = number of cells
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_field, float, Kokkos::LayoutRight, Kokkos::Serial, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_field, float, Kokkos::LayoutLeft, Kokkos::Serial, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_component, float, Kokkos::LayoutRight, Kokkos::Serial, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_component, float, Kokkos::LayoutLeft, Kokkos::Serial, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+BENCHMARK_TEMPLATE(VIEW_all_kokkos, float, Kokkos::OpenMP)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_subview, float, Kokkos::OpenMP)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_subview_range, float, Kokkos::OpenMP, 0)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_subview_range, float, Kokkos::OpenMP, 1)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_masked, float, Kokkos::OpenMP)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+// 4 components per cell, range(0) = number of cells
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_field, float, Kokkos::LayoutRight, Kokkos::OpenMP, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_field, float, Kokkos::LayoutLeft, Kokkos::OpenMP, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_component, float, Kokkos::LayoutRight, Kokkos::OpenMP, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+BENCHMARK_TEMPLATE(VIEW_all_kokkos_component, float, Kokkos::LayoutLeft, Kokkos::OpenMP, 4)->Apply([](benchmark::internal::Benchmark* b) {CustomArguments(b, min, max, threshold1, threshold2);})->UseRealTime();
+#endif
+#endif
+
+#ifdef XBENCHMARK_USE_KOKKOS
+XBENCHMARK_KOKKOS_MAIN();
+#else
 BENCHMARK_MAIN();
+#endif
 
 
 
@@ -18,6 +18,7 @@
 #endif
 
 #include <utils/custom_arguments.hpp>
+#include <allocation/huge_pages.hpp>
 int min = 1 ;
 int max = 1000000 ;
 int threshold1 = 1024 ;
@@ -37,10 +38,10 @@ void VIEW_stride_aligned(benchmark::State& state) {
 
         constexpr std::size_t alignment = 64;
 
-        // Allocate aligned memory using std::aligned_alloc
-        T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-        T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-        T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
+        // Allocate aligned memory (default_page_alloc : 4 KB or huge pages, see XBENCHMARK_PAGES)
+        T* vec1 = default_page_alloc<T>(vector_size, alignment);
+        T* vec2 = default_page_alloc<T>(vector_size, alignment);
+        T* result = default_page_alloc<T>(vector_size, alignment);
         // Initialize arrays
         for (int i = 0; i < vector_size; ++i) {
                 vec1[i] = 1;
@@ -55,9 +56,9 @@ void VIEW_stride_aligned(benchmark::State& state) {
                 benchmark::DoNotOptimize(result); // Prevent compiler optimizations
         }
         // Free aligned memory
-        std::free(vec1);
-        std::free(vec2);
-        std::free(result);
+        default_page_free(vec1);
+        default_page_free(vec2);
+        default_page_free(result);
         state.SetItemsProcessed(state.iterations() * vector_size);
 }
 
@@ -68,11 +69,11 @@ void VIEW_stride_aligned_masked(benchmark::State& state) {
 	const int vector_size = state.range(0);
 
 	constexpr std::size_t alignment = 64;
-	// Allocate aligned memory using std::aligned_alloc
-	T* vec1 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* vec2 = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	T* result = static_cast<T*>(std::aligned_alloc(alignment, vector_size * sizeof(T)));
-	bool* mask = static_cast<bool*>(std::aligned_alloc(alignment, vector_size * sizeof(bool))) ; 
+	// Allocate aligned memory (default_page_alloc : 4 KB or huge pages, see XBENCHMARK_PAGES)
+	T* vec1 = default_page_alloc<T>(vector_size, alignment);
+	T* vec2 = default_page_alloc<T>(vector_size, alignment);
+	T* result = default_page_alloc<T>(vector_size, alignment);
+	bool* mask = default_page_alloc<bool>(vector_size, alignment) ; 
 	// Initialize arrays
 	for (int i = 0; i < vector_size; ++i) {
 		vec1[i] = 1;
@@ -94,10 +95,10 @@ void VIEW_stride_aligned_masked(benchmark::State& state) {
 		benchmark::DoNotOptimize(result); // Prevent compiler optimizations
 	}
 	// Free aligned memory
-	std::free(vec1);
-	std::free(vec2);
-	std::free(result);
-	std::free(mask);
+	default_page_free(vec1);
+	default_page_free(vec2);
+	default_page_free(result);
+	default_page_free(mask);
 	state.SetItemsProcessed(state.iterations() * vector_size);
 }
 